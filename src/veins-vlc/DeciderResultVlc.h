@@ -0,0 +1,44 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins/modules/phy/DeciderResult80211.h"
+#include "veins-vlc/utility/ObjectPool.h"
+
+namespace veins {
+
+/**
+ * @brief DeciderResult80211 of DeciderVlc, allocated from an ObjectPool
+ *
+ * Used for all results of DeciderVlc, also for frames which are not
+ * decoded and thus never reach the MAC layer.
+ */
+class VEINS_VLC_API DeciderResultVlc : public DeciderResult80211, public Pooled<DeciderResultVlc> {
+public:
+    DeciderResultVlc(bool isCorrect, double bitrate = 0, double snr = 0, double recvPower_dBm = 0, bool collision = false)
+        : DeciderResult80211(isCorrect, bitrate, snr, recvPower_dBm, collision)
+    {
+    }
+};
+
+} // namespace veins
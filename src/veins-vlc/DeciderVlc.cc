@@ -24,7 +24,7 @@
  */
 
 #include "veins-vlc/DeciderVlc.h"
-#include "veins/modules/phy/DeciderResult80211.h"
+#include "veins-vlc/DeciderResultVlc.h"
 #include "veins/base/toolbox/Signal.h"
 #include "veins/modules/messages/AirFrame11p_m.h"
 #include "veins/modules/utility/ConstsPhy.h"
@@ -32,10 +32,15 @@
 #include "veins-vlc/messages/AirFrameVlc_m.h"
 #include "veins/modules/utility/Consts80211p.h"
 #include "veins-vlc/utility/Utils.h"
+#include "veins-vlc/utility/PhyModesVlc.h"
 #include "veins/base/utils/FWMath.h"
 
 #include "veins/base/toolbox/SignalUtils.h"
 
+#include <algorithm>
+#include <cctype>
+#include <vector>
+
 using namespace veins;
 
 #define EV_TRACE \
@@ -43,23 +48,45 @@ using namespace veins;
 
 using veins::AirFrame;
 
+const simsignal_t DeciderVlc::sinrDecodedSignal = cComponent::registerSignal("vlcSinrDecoded");
+const simsignal_t DeciderVlc::sinrNotDecodedSignal = cComponent::registerSignal("vlcSinrNotDecoded");
+const simsignal_t DeciderVlc::sinrCollisionSignal = cComponent::registerSignal("vlcSinrCollision");
+const simsignal_t DeciderVlc::underMinPowerLevelSignal = cComponent::registerSignal("vlcUnderMinPowerLevel");
+
 simtime_t DeciderVlc::processNewSignal(AirFrame* msg)
 {
 
     AirFrameVlc* frame = check_and_cast<AirFrameVlc*>(msg);
 
-    // get the receiving power of the Signal at start-time and center frequency
+    // get the receiving power of the Signal at start-time and center frequency;
+    // frames on other optical bands are filtered by the photodiode
     Signal& signal = frame->getSignal();
-    double recvPower = signal.getAtCenterFrequency();
+    double recvPower = 0;
+    if (signal.getCenterFrequencyIndex() == opticalBand) {
+        if (frame->getReceivedPower() >= 0) {
+            // already computed as a scalar by PhyLayerVlc
+            recvPower = frame->getReceivedPower();
+        }
+        else {
+            // thresholding analogue models are only applied on demand
+            signal.applyAllAnalogueModels();
+            recvPower = signal.getAtCenterFrequency();
+        }
+    }
+    frame->setReceivedPower(recvPower);
 
-    signalStates[frame] = EXPECT_END;
+    frame->setReceptionState(EXPECT_END);
+    ++framesOnAir;
+    changeChannelPower(recvPower);
 
-    if (signal.smallerAtCenterFrequency(minPowerLevel)) {
+    if (recvPower < minPowerLevel) {
 
         EV_TRACE << "AirFrame: " << frame->getId() << " with recvPower (" << recvPower << " < " << minPowerLevel << ") -> AirFrame can't be detected by the radio; discarded at its end." << std::endl;
 
         // annotate the frame, so that we won't try decoding it at its end
         frame->setUnderMinPowerLevel(true);
+        framesUnderMinPowerLevel++;
+        module->emit(underMinPowerLevelSignal, recvPower);
         return signal.getReceptionEnd();
     }
     else {
@@ -67,16 +94,24 @@ simtime_t DeciderVlc::processNewSignal(AirFrame* msg)
         // This value might be just an intermediate result (due to short circuiting)
         setChannelIdleStatus(false);
 
-        myBusyTime += signal.getDuration().dbl();
+        changeDetectedFrames(1);
 
-        if (!currentSignal.first) {
+        if (!fullDuplex && simTime() < transmissionEnd) {
+            // NIC is transmitting and cannot receive at the same time. this frame will be simply treated as interference
+            EV_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Currently transmitting. Treating AirFrame as interference." << std::endl;
+            framesMissedWhileTransmitting++;
+        }
+        else if (!currentSignal.first) {
             // NIC is not yet synced to any frame, so lock and try to decode this frame
             currentSignal.first = frame;
+            syncedInterference.clear();
+            syncedInterference.push_back({simTime(), std::max(0.0, channelPower - recvPower)});
             EV_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Trying to receive AirFrame." << std::endl;
         }
         else {
             // NIC is currently trying to decode another frame. this frame will be simply treated as interference
             EV_TRACE << "AirFrame: " << frame->getId() << " with (" << recvPower << " > " << minPowerLevel << ") -> Already synced to another AirFrame. Treating AirFrame as interference." << std::endl;
+            framesMissedWhileSynced++;
         }
         return signal.getReceptionEnd();
     }
@@ -84,52 +119,48 @@ simtime_t DeciderVlc::processNewSignal(AirFrame* msg)
 
 int DeciderVlc::getSignalState(AirFrame* frame)
 {
-
-    if (signalStates.find(frame) == signalStates.end()) {
-        return NEW;
-    }
-    else {
-        return signalStates[frame];
-    }
+    return check_and_cast<AirFrameVlc*>(frame)->getReceptionState();
 }
 
-DeciderResult* DeciderVlc::checkIfSignalOk(AirFrame* frame)
+DeciderResult* DeciderVlc::checkIfSignalOk(AirFrame* msg)
 {
+    AirFrameVlc* frame = check_and_cast<AirFrameVlc*>(msg);
 
     Signal& s = frame->getSignal();
     simtime_t start = s.getReceptionStart();
     simtime_t end = s.getReceptionEnd();
 
     // compute receive power
-    double recvPower_dBm = 10 * log10(s.getAtCenterFrequency());
+    double recvPower = frame->getReceivedPower();
+    double recvPower_dBm = 10 * log10(recvPower);
 
-    start = start + PHY_VLC_SHR / bitrate; // its ok if something in the training phase is broken
+    int phyMode = frame->getPhyMode();
+    double rate = (phyMode == -1) ? bitrate : getVlcPhyMode(phyMode).getDataRate();
 
-    AirFrameVector airFrames;
-    getChannelInfo(start, end, airFrames);
+    start = start + PHY_VLC_SHR / rate; // its ok if something in the training phase is broken
 
     double noise = phy->getNoiseFloorValue();
 
-    // Make sure to use the adjusted starting-point (which ignores the preamble)
-    double sinrMin = SignalUtils::getMinSINR(start, end, frame, airFrames, noise);
-    double snrMin;
-    if (collectCollisionStats) {
-        // snrMin = SignalUtils::getMinSNR(start, end, frame, noise);
-        snrMin = s.getDataMin() / noise;
-    }
-    else {
-        // just set to any value. if collectCollisionStats != true
-        // it will be ignored by packetOk
-        snrMin = 1e200;
-    }
+    // Make sure to use the adjusted starting-point (which ignores the preamble).
+    // Without any other frame since its start, the SINR is the SNR
+    bool alone = syncedInterference.size() == 1 && syncedInterference.front().second == 0;
+    double sinrMin = alone ? recvPower / noise : getMinSinr(start, end, frame, noise);
+    double snrMin = recvPower / noise;
 
-    DeciderResult80211* result = 0;
+    DeciderResultVlc* result = 0;
 
-    switch (packetOk(sinrMin, snrMin, frame->getBitLength())) {
+    auto packetResult = thresholdDecoding ? packetOkThreshold(sinrMin, snrMin, frame->getBitLength(), phyMode) : packetOk(sinrMin, snrMin, frame->getBitLength(), phyMode);
+    if (packetResult == COLLISION) {
+        syncsLostToInterference++;
+        if (!collectCollisionStats) packetResult = NOT_DECODED;
+    }
+    switch (packetResult) {
 
     case DECODED:
         EV_TRACE << "Packet is fine! We can decode it" << std::endl;
-        result = new DeciderResult80211(true, 0, sinrMin, recvPower_dBm, false);
+        result = new DeciderResultVlc(true, rate, sinrMin, recvPower_dBm, false);
+        framesDecoded++;
+        module->emit(sinrDecodedSignal, 10 * log10(sinrMin));
         break;
 
     case NOT_DECODED:
@@ -139,13 +170,16 @@ DeciderResult* DeciderVlc::checkIfSignalOk(AirFrame* frame)
         else {
             EV_TRACE << "Packet has bit Errors due to low power. Lost " << std::endl;
         }
-        result = new DeciderResult80211(false, 0, sinrMin, recvPower_dBm, false);
+        result = new DeciderResultVlc(false, rate, sinrMin, recvPower_dBm, false);
+        framesNotDecoded++;
+        module->emit(sinrNotDecodedSignal, 10 * log10(sinrMin));
         break;
 
     case COLLISION:
         EV_TRACE << "Packet has bit Errors due to collision. Lost " << std::endl;
         collisions++;
-        result = new DeciderResult80211(false, 0, sinrMin, recvPower_dBm, true);
+        result = new DeciderResultVlc(false, rate, sinrMin, recvPower_dBm, true);
+        module->emit(sinrCollisionSignal, 10 * log10(sinrMin));
         break;
 
     default:
@@ -156,84 +190,144 @@ DeciderResult* DeciderVlc::checkIfSignalOk(AirFrame* frame)
     return result;
 }
 
-enum DeciderVlc::PACKET_OK_RESULT DeciderVlc::packetOk(double sinrMin, double snrMin, int lengthMPDU)
+double DeciderVlc::getMinSinr(simtime_t start, simtime_t end, AirFrameVlc* frame, double noise) const
 {
-    // compute success rate depending on mcs and packet length
-    double packetOkSinr = getOokPdr(sinrMin, lengthMPDU); // PDR w/o FEC
+    // Each level lasts until the next change; levels not overlapping [start, end) for some time do not count,
+    // e.g., of frames ending at start or starting at end. Frames on other optical bands and the apertures
+    // of other deciders do not arrive here, or with a received power of 0
+    double maxInterference = 0;
+    for (size_t i = 0; i < syncedInterference.size(); ++i) {
+        simtime_t levelStart = std::max(syncedInterference[i].first, start);
+        simtime_t levelEnd = (i + 1 < syncedInterference.size()) ? std::min(syncedInterference[i + 1].first, end) : end;
+        if (levelStart >= levelEnd) continue;
+        maxInterference = std::max(maxInterference, syncedInterference[i].second);
+    }
 
-    // check if header is broken
-    double headerOkSinr = getOokPdr(sinrMin, PHY_VLC_SHR);
+    return frame->getReceivedPower() / (noise + maxInterference);
+}
 
-    double packetOkSnr;
-    double headerOkSnr;
+void DeciderVlc::changeChannelPower(double power)
+{
+    channelPower += power;
+    // avoid accumulating rounding errors
+    if (framesOnAir == 0) channelPower = 0;
 
-    // compute PER also for SNR only
-    if (collectCollisionStats) {
+    if (currentSignal.first) {
+        double syncedPower = check_and_cast<AirFrameVlc*>(currentSignal.first)->getReceivedPower();
+        syncedInterference.push_back({simTime(), std::max(0.0, channelPower - syncedPower)});
+    }
+}
 
-        packetOkSnr = getOokPdr(snrMin, lengthMPDU);
+void DeciderVlc::changeDetectedFrames(int count)
+{
+    bool wasBusy = detectedFramesOnAir > 0;
+    detectedFramesOnAir += count;
+    bool isBusy = detectedFramesOnAir > 0;
 
-        headerOkSnr = getOokPdr(snrMin, PHY_VLC_SHR);
+    if (!wasBusy && isBusy) {
+        busyStart = simTime();
+    }
+    else if (wasBusy && !isBusy) {
+        myBusyTime += (simTime() - busyStart).dbl();
+    }
+}
 
-        // the probability of correct reception without considering the interference
-        // MUST be greater or equal than when consider it
+OokPdrTable& DeciderVlc::getSharedOokPdrTable()
+{
+    static OokPdrTable table;
+    return table;
+}
 
-        ASSERT(close(packetOkSnr, packetOkSinr) || (packetOkSnr > packetOkSinr));
-        ASSERT(close(headerOkSnr, headerOkSinr) || (headerOkSnr > headerOkSinr));
+double DeciderVlc::getPdr(double sinr, int length, int phyMode) const
+{
+    return getPdr(sinr, length, phyMode, bitrate, ookPdrTable);
+}
+
+double DeciderVlc::getPdr(double sinr, int length, int phyMode, double bitrate, OokPdrTable* ookPdrTable)
+{
+    if (phyMode == -1) {
+        // PDR w/o FEC
+        return ookPdrTable ? ookPdrTable->getPdr(sinr, length) : getOokPdr(sinr, length);
+    }
+    const VlcPhyMode& mode = getVlcPhyMode(phyMode);
+    return getVlcPhyModePdr(mode, getVlcPhyModeSnr(mode, sinr, bitrate), length);
+}
+
+std::map<std::tuple<int, double, double, bool>, PdrThresholds>& DeciderVlc::getSharedPdrThresholds()
+{
+    static std::map<std::tuple<int, double, double, bool>, PdrThresholds> thresholds;
+    return thresholds;
+}
+
+PdrThresholds& DeciderVlc::getPdrThresholds(int phyMode)
+{
+    auto it = pdrThresholds.find(phyMode);
+    if (it != pdrThresholds.end()) return *it->second;
+
+    auto& sharedThresholds = getSharedPdrThresholds();
+    auto key = std::make_tuple(phyMode, bitrate, targetPdr, ookPdrTable != nullptr);
+    auto shared = sharedThresholds.find(key);
+    if (shared == sharedThresholds.end()) {
+        // Thresholds are on the SINR at the bitrate of the NIC, as getPdr; they must not depend on this decider
+        double bitrate = this->bitrate;
+        OokPdrTable* ookPdrTable = this->ookPdrTable;
+        PdrThresholds::PdrFunction pdr = [phyMode, bitrate, ookPdrTable](double sinr, int length) {
+            return getPdr(sinr, length, phyMode, bitrate, ookPdrTable);
+        };
+        shared = sharedThresholds.emplace(key, PdrThresholds(pdr, targetPdr)).first;
     }
+    pdrThresholds[phyMode] = &shared->second;
+    return shared->second;
+}
+
+enum DeciderVlc::PACKET_OK_RESULT DeciderVlc::packetOkThreshold(double sinrMin, double snrMin, int lengthMPDU, int phyMode)
+{
+    PdrThresholds& thresholds = getPdrThresholds(phyMode);
+    double headerThreshold = thresholds.getThreshold(PHY_VLC_SHR);
+    double packetThreshold = thresholds.getThreshold(lengthMPDU);
+
+    if (sinrMin >= headerThreshold && sinrMin >= packetThreshold) return DECODED;
+
+    // would we have decoded the frame without interference?
+    if (snrMin >= headerThreshold && snrMin >= packetThreshold) return COLLISION;
+    return NOT_DECODED;
+}
+
+enum DeciderVlc::PACKET_OK_RESULT DeciderVlc::packetOk(double sinrMin, double snrMin, int lengthMPDU, int phyMode)
+{
+    // compute success rate depending on mcs and packet length
+    double packetOkSinr = getPdr(sinrMin, lengthMPDU, phyMode);
+
+    // check if header is broken
+    double headerOkSinr = getPdr(sinrMin, PHY_VLC_SHR, phyMode);
 
     // probability of no bit error in the PLCP header
 
     double rand = RNGCONTEXT dblrand();
 
-    if (!collectCollisionStats) {
-        if (rand > headerOkSinr) return NOT_DECODED;
-    }
-    else {
+    if (rand > headerOkSinr) {
+        // ups, we have a header error. is that due to interference?
+        // the probability of correct reception without considering the interference
+        // MUST be greater or equal than when consider it
+        double headerOkSnr = getPdr(snrMin, PHY_VLC_SHR, phyMode);
+        ASSERT(close(headerOkSnr, headerOkSinr) || (headerOkSnr > headerOkSinr));
 
-        if (rand > headerOkSinr) {
-            // ups, we have a header error. is that due to interference?
-            if (rand > headerOkSnr) {
-                // no. we would have not been able to receive that even
-                // without interference
-                return NOT_DECODED;
-            }
-            else {
-                // yes. we would have decoded that without interference
-                return COLLISION;
-            }
-        }
+        // if not, we would have not been able to receive that even without interference
+        return (rand > headerOkSnr) ? NOT_DECODED : COLLISION;
     }
 
     // probability of no bit error in the rest of the packet
 
     rand = RNGCONTEXT dblrand();
 
-    if (!collectCollisionStats) {
-        if (rand > packetOkSinr) {
-            return NOT_DECODED;
-        }
-        else {
-            return DECODED;
-        }
-    }
-    else {
+    if (rand > packetOkSinr) {
+        // ups, we have an error in the payload. is that due to interference?
+        double packetOkSnr = getPdr(snrMin, lengthMPDU, phyMode);
+        ASSERT(close(packetOkSnr, packetOkSinr) || (packetOkSnr > packetOkSinr));
 
-        if (rand > packetOkSinr) {
-            // ups, we have an error in the payload. is that due to interference?
-            if (rand > packetOkSnr) {
-                // no. we would have not been able to receive that even
-                // without interference
-                return NOT_DECODED;
-            }
-            else {
-                // yes. we would have decoded that without interference
-                return COLLISION;
-            }
-        }
-        else {
-            return DECODED;
-        }
+        return (rand > packetOkSnr) ? NOT_DECODED : COLLISION;
     }
+    return DECODED;
 }
 
 simtime_t DeciderVlc::processSignalEnd(AirFrame* msg)
@@ -242,13 +336,13 @@ simtime_t DeciderVlc::processSignalEnd(AirFrame* msg)
     AirFrameVlc* frame = check_and_cast<AirFrameVlc*>(msg);
 
     // remove this frame from our current signals
-    signalStates.erase(frame);
+    frame->setReceptionState(NEW);
 
     DeciderResult* result;
 
     if (frame->getUnderMinPowerLevel()) {
         // this frame was not even detected by the radio card
-        result = new DeciderResult(false);
+        result = new DeciderResultVlc(false);
     }
     else {
 
@@ -261,13 +355,19 @@ simtime_t DeciderVlc::processSignalEnd(AirFrame* msg)
             // after having tried to decode the frame, the NIC is no more synced to the frame
             // and it is ready for syncing on a new one
             currentSignal.first = 0;
+            syncedInterference.clear();
         }
         else {
             // if this is not the frame we are synced on, we cannot receive it
-            result = new DeciderResult(false);
+            result = new DeciderResultVlc(false);
         }
     }
 
+    // the frame no longer interferes with the others
+    --framesOnAir;
+    changeChannelPower(-frame->getReceivedPower());
+    if (!frame->getUnderMinPowerLevel()) changeDetectedFrames(-1);
+
     if (result->isSignalCorrect()) {
         EV_TRACE << "packet was received correctly, it is now handed to upper layer...\n";
         // go on with processing this AirFrame, send it to the Mac-Layer
@@ -281,8 +381,49 @@ simtime_t DeciderVlc::processSignalEnd(AirFrame* msg)
     return notAgain;
 }
 
+void DeciderVlc::switchToTx()
+{
+    if (fullDuplex || !currentSignal.first) return;
+
+    // the frame will not be received at its end, as the NIC is no longer synced to it
+    EV_TRACE << "AirFrame: " << currentSignal.first->getId() << " -> Starting to transmit. Aborting reception." << std::endl;
+    receptionsAborted++;
+    currentSignal.first = 0;
+    syncedInterference.clear();
+}
+
+void DeciderVlc::recordScalar(const std::string& name, double value)
+{
+    if (statisticsPrefix.empty()) {
+        phy->recordScalar(name.c_str(), value);
+        return;
+    }
+    std::string prefixedName = statisticsPrefix + name;
+    prefixedName[statisticsPrefix.size()] = static_cast<char>(std::toupper(name[0]));
+    phy->recordScalar(prefixedName.c_str(), value);
+}
+
 void DeciderVlc::finish()
 {
+    // account the busy period lasting until the end of the simulation
+    double busyTime = myBusyTime;
+    if (detectedFramesOnAir > 0) busyTime += (simTime() - busyStart).dbl();
+
+    simtime_t totalTime = simTime() - myStartTime;
+    recordScalar("busyTime", busyTime);
+    recordScalar("channelBusyRatio", totalTime > 0 ? busyTime / totalTime.dbl() : 0);
+    recordScalar("framesDecoded", framesDecoded);
+    recordScalar("framesNotDecoded", framesNotDecoded);
+    recordScalar("framesUnderMinPowerLevel", framesUnderMinPowerLevel);
+    recordScalar("framesMissedWhileSynced", framesMissedWhileSynced);
+    recordScalar("syncsLostToInterference", syncsLostToInterference);
+    if (!fullDuplex) {
+        recordScalar("framesMissedWhileTransmitting", framesMissedWhileTransmitting);
+        recordScalar("receptionsAborted", receptionsAborted);
+    }
+    if (collectCollisionStats) {
+        recordScalar("ncollisions", collisions);
+    }
 }
 
 DeciderVlc::~DeciderVlc(){};
@@ -27,7 +27,18 @@
 
 #pragma once
 
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
 #include "veins/base/phyLayer/BaseDecider.h"
+#include "veins-vlc/messages/AirFrameVlc_m.h"
+#include "veins-vlc/utility/OokPdrTable.h"
+#include "veins-vlc/utility/PdrThresholds.h"
 
 namespace veins {
 
@@ -45,7 +56,7 @@ using veins::AirFrame;
  * @see PhyLayerVlc
  * @see DeciderVlc
  */
-class DeciderVlc : public BaseDecider {
+class VEINS_VLC_API DeciderVlc : public BaseDecider {
 public:
     enum PACKET_OK_RESULT {
         DECODED,
@@ -57,13 +68,84 @@ protected:
     bool debug = true;
     double bitrate;
 
+    /** @brief Module the signals of this decider are emitted on, i.e., its PhyLayerVlc */
+    cComponent* module;
+    /** @brief Prepended to the names of the scalars of this decider, see setStatisticsPrefix */
+    std::string statisticsPrefix;
+
+    /** @brief Time the channel was busy, i.e., with any frame above minPowerLevel, up to busyStart */
     double myBusyTime;
     double myStartTime;
+    /** @brief Number of frames above minPowerLevel currently arriving at this decider */
+    int detectedFramesOnAir = 0;
+    /** @brief Start of the current busy period */
+    simtime_t busyStart;
 
-    std::map<AirFrame*, int> signalStates;
+    /** @brief Whether frames lost to interference are reported as collisions rather than as not decoded */
     bool collectCollisionStats;
     unsigned int collisions;
 
+    unsigned int framesDecoded = 0;
+    unsigned int framesNotDecoded = 0;
+    unsigned int framesUnderMinPowerLevel = 0;
+    /** @brief Frames above minPowerLevel not synced to as the NIC already was synced to another frame */
+    unsigned int framesMissedWhileSynced = 0;
+    /** @brief Frames synced to but not decoded, which would have been decoded without interference */
+    unsigned int syncsLostToInterference = 0;
+    /** @brief Frames above minPowerLevel not synced to as the NIC was transmitting */
+    unsigned int framesMissedWhileTransmitting = 0;
+    /** @brief Receptions aborted by a transmission of the NIC */
+    unsigned int receptionsAborted = 0;
+
+    /** @brief SINR in dB of frames decoded, lost, or lost due to interference, respectively */
+    static const simsignal_t sinrDecodedSignal;
+    static const simsignal_t sinrNotDecodedSignal;
+    static const simsignal_t sinrCollisionSignal;
+    /** @brief Received power in mW of frames below minPowerLevel */
+    static const simsignal_t underMinPowerLevelSignal;
+
+    /** @brief Whether frames can be received while transmitting */
+    bool fullDuplex;
+    /** @brief End of the current (or last) own transmission */
+    simtime_t transmissionEnd;
+
+    /** @brief Frequency index of the optical band the NIC receives on */
+    size_t opticalBand;
+
+    /** @brief Aperture (photodiode) of the NIC this decider receives on */
+    int aperture;
+
+    /** @brief Sum of the received power of all frames currently arriving at this decider */
+    double channelPower = 0;
+    /** @brief Number of frames currently arriving at this decider */
+    int framesOnAir = 0;
+    /**
+     * @brief Interference of the frame the NIC is synced to: the power of
+     * all other frames from each change on, starting with its own start
+     */
+    std::vector<std::pair<simtime_t, double>> syncedInterference;
+
+    /** @brief Table to look up the PDR of frames sent without an operating mode in, nullptr to compute it */
+    OokPdrTable* ookPdrTable;
+
+    /** @brief Returns the OokPdrTable shared by all deciders */
+    static OokPdrTable& getSharedOokPdrTable();
+
+    /** @brief Whether frames are decoded iff their SINR reaches the one at which the PDR is targetPdr */
+    bool thresholdDecoding = false;
+    double targetPdr = 0;
+    /** @brief SINR thresholds per operating mode (-1 for OOK at bitrate), see getPdrThresholds */
+    std::map<int, PdrThresholds*> pdrThresholds;
+
+    /** @brief Returns the SNR thresholds of frames sent with the given operating mode */
+    PdrThresholds& getPdrThresholds(int phyMode);
+
+    /**
+     * @brief Returns the SNR thresholds shared by all deciders, by operating
+     * mode, bitrate, targetPdr and whether the OokPdrTable is used
+     */
+    static std::map<std::tuple<int, double, double, bool>, PdrThresholds>& getSharedPdrThresholds();
+
 protected:
     /**
      * @brief Checks a mapping against a specific threshold (element-wise).
@@ -88,23 +170,114 @@ protected:
      */
     virtual simtime_t processSignalEnd(AirFrame* frame);
 
-    /** @brief computes if packet is ok or has errors*/
-    enum DeciderVlc::PACKET_OK_RESULT packetOk(double snirMin, double snrMin, int lengthMPDU);
+    /**
+     * @brief Returns the minimum SINR of the frame the NIC is synced to
+     * between start and end.
+     *
+     * Same as SignalUtils::getMinSINR, but as VLC signals have a single
+     * carrier and are constant over their duration, the interference only
+     * changes as frames start and end, which syncedInterference records.
+     */
+    double getMinSinr(simtime_t start, simtime_t end, AirFrameVlc* frame, double noise) const;
+
+    /**
+     * @brief Adds power to the power of the frames arriving at this
+     * decider (negative as they end), recording the change for the frame
+     * the NIC is synced to
+     */
+    void changeChannelPower(double power);
+
+    /**
+     * @brief Adds count to the number of frames above minPowerLevel
+     * arriving at this decider (negative as they end), accounting the
+     * time the channel is busy with any of them
+     */
+    void changeDetectedFrames(int count);
+
+    /** @brief Records a scalar with the name prefixed by statisticsPrefix */
+    void recordScalar(const std::string& name, double value);
+
+    /**
+     * @brief Returns the probability to receive length bits without error,
+     * sent with the given operating mode (-1 for OOK at bitrate)
+     */
+    double getPdr(double sinr, int length, int phyMode) const;
+
+    /** @brief Same as getPdr, for any bitrate and OokPdrTable (nullptr to compute the PDR) */
+    static double getPdr(double sinr, int length, int phyMode, double bitrate, OokPdrTable* ookPdrTable);
+
+    /**
+     * @brief computes if packet is ok or has errors, telling apart errors
+     * which would not have occurred at snrMin, i.e., without interference
+     */
+    enum DeciderVlc::PACKET_OK_RESULT packetOk(double snirMin, double snrMin, int lengthMPDU, int phyMode = -1);
+
+    /**
+     * @brief Same as packetOk, but deterministic: header and payload are
+     * decoded iff the SINR reaches their threshold for targetPdr
+     */
+    enum DeciderVlc::PACKET_OK_RESULT packetOkThreshold(double snirMin, double snrMin, int lengthMPDU, int phyMode = -1);
 
 public:
     /**
      * @brief Initializes the Decider with a pointer to its PhyLayer and
      * specific values for threshold and sensitivity
      */
-    DeciderVlc(cComponent* owner, DeciderToPhyInterface* phy, double sensitivity, double bRate, int myIndex = -1, bool collectCollisionStatistics = false)
+    DeciderVlc(cComponent* owner, DeciderToPhyInterface* phy, double sensitivity, double bRate, int myIndex = -1, bool collectCollisionStatistics = false, bool fullDuplex = true, size_t opticalBand = 0, int aperture = 0, bool usePdrTable = false)
         : BaseDecider(owner, phy, sensitivity, myIndex)
         , bitrate(bRate)
+        , module(owner)
         , myBusyTime(0)
         , myStartTime(simTime().dbl())
         , collectCollisionStats(collectCollisionStatistics)
+        , collisions(0)
+        , fullDuplex(fullDuplex)
+        , transmissionEnd(0)
+        , opticalBand(opticalBand)
+        , aperture(aperture)
+        , ookPdrTable(usePdrTable ? &getSharedOokPdrTable() : nullptr)
     {
     }
 
+    /**
+     * @brief Decodes frames by comparing their SINR against the SINR at
+     * which their PDR reaches targetPdr, without drawing random numbers
+     */
+    void setThresholdDecoding(double targetPdr)
+    {
+        thresholdDecoding = true;
+        this->targetPdr = targetPdr;
+        pdrThresholds.clear();
+    }
+
+    /**
+     * @brief Prepends prefix to the names of the scalars this decider
+     * records, for several deciders of the same PhyLayerVlc
+     */
+    void setStatisticsPrefix(std::string prefix)
+    {
+        statisticsPrefix = prefix;
+    }
+
+    /**
+     * @brief Unless in full-duplex mode, aborts the reception of the
+     * frame the NIC is currently synced to
+     */
+    void switchToTx() override;
+
+    /**
+     * @brief Unless in full-duplex mode, frames starting before end are
+     * only treated as interference
+     */
+    void setTransmissionEnd(simtime_t end)
+    {
+        transmissionEnd = end;
+    }
+
+    /**
+     * @brief Returns the state of the reception of frame, stored in the
+     * copy of the AirFrameVlc of this NIC
+     */
     int getSignalState(AirFrame* frame);
     virtual ~DeciderVlc();
     /**
@@ -0,0 +1,50 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/DeciderVlcApertures.h"
+
+using namespace veins;
+
+simtime_t DeciderVlcApertures::processSignal(AirFrame* frame)
+{
+    AirFrameVlc* frameVlc = check_and_cast<AirFrameVlc*>(frame);
+    return deciders.at(frameVlc->getRxAperture())->processSignal(frame);
+}
+
+void DeciderVlcApertures::switchToTx()
+{
+    for (auto& decider : deciders) {
+        decider->switchToTx();
+    }
+}
+
+void DeciderVlcApertures::setTransmissionEnd(simtime_t end)
+{
+    for (auto& decider : deciders) {
+        decider->setTransmissionEnd(end);
+    }
+}
+
+void DeciderVlcApertures::finish()
+{
+    for (auto& decider : deciders) {
+        decider->finish();
+    }
+}
@@ -0,0 +1,65 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "veins-vlc/DeciderVlc.h"
+
+namespace veins {
+
+/**
+ * @brief Decider of a PhyLayerVlc with several apertures
+ *
+ * Holds one DeciderVlc per aperture (photodiode) and hands each frame
+ * to the one of the aperture the PhyLayerVlc receives it on, see
+ * AirFrameVlc::rxAperture. Each photodiode thus syncs to its own
+ * frames and only sees the interference arriving at it.
+ *
+ * @see PhyLayerVlcVehicle
+ */
+class DeciderVlcApertures : public Decider {
+public:
+    DeciderVlcApertures(cComponent* owner, DeciderToPhyInterface* phy, std::vector<std::unique_ptr<DeciderVlc>> deciders)
+        : Decider(owner, phy)
+        , deciders(std::move(deciders))
+    {
+    }
+
+    simtime_t processSignal(AirFrame* frame) override;
+
+    void switchToTx() override;
+
+    /**
+     * @brief See DeciderVlc::setTransmissionEnd, a transmission blinds
+     * all apertures
+     */
+    void setTransmissionEnd(simtime_t end);
+
+    void finish() override;
+
+protected:
+    /** @brief One decider per aperture, indexed by aperture */
+    std::vector<std::unique_ptr<DeciderVlc>> deciders;
+};
+
+} // namespace veins
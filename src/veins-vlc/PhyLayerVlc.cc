@@ -25,23 +25,35 @@
 #include "veins-vlc/PhyLayerVlc.h"
 
 #include "veins-vlc/DeciderVlc.h"
+#include "veins-vlc/VlcConnectionManager.h"
 #include "veins-vlc/analogueModel/VehicleObstacleShadowingForVlc.h"
 #include "veins/base/connectionManager/BaseConnectionManager.h"
+#include "veins/base/modules/BaseMobility.h"
 #include "veins/modules/messages/AirFrame11p_m.h"
 #include "veins-vlc/messages/AirFrameVlc_m.h"
 #include "veins-vlc/AntennaHeadlight.h"
 #include "veins-vlc/AntennaTaillight.h"
+#include "veins-vlc/mac/MacPktVlc.h"
+#include "veins-vlc/utility/PhyModesVlc.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
 
 using namespace veins;
 
 using std::unique_ptr;
 
 Define_Module(veins::PhyLayerVlc);
+Register_Class(AirFrameVlc);
 
 /* Used for the LsvLightModel */
 bool PhyLayerVlc::mapsInitialized = false;
 std::map<std::string, Photodiode> PhyLayerVlc::photodiodeMap = std::map<std::string, Photodiode>();
 std::map<std::string, RadiationPattern> PhyLayerVlc::radiationPatternMap = std::map<std::string, RadiationPattern>();
+PrototypeRegistry<PhyLayerVlc::AnalogueModelPrototype> PhyLayerVlc::lightModelPrototypes;
+PrototypeRegistry<Antenna> PhyLayerVlc::antennaPrototypes;
+PrototypeRegistry<TxCone> PhyLayerVlc::txConePrototypes;
 
 void PhyLayerVlc::initialize(int stage)
 {
@@ -51,21 +63,312 @@ void PhyLayerVlc::initialize(int stage)
             error("You have set the wrong reference power (txPower) in omnetpp.ini. Should be fixed to: FIXED_REFERENCE_POWER");
         bitrate = par("bitrate").doubleValue();
         collectCollisionStatistics = par("collectCollisionStatistics").boolValue();
+        useLinkCache = par("useLinkCache").boolValue();
+        senderSideCulling = par("senderSideCulling").boolValue();
+        fullDuplex = par("fullDuplex").boolValue();
+        usePdrTable = par("usePdrTable").boolValue();
+        hostId = findHost()->getId();
 
         // Create frequency mappings and initialize spectrum for signal representation
-        overallSpectrum = Spectrum({666e12});
+        opticalBands = parseOpticalBands(par("opticalBands").stdstringValue());
+        int band = par("opticalBand");
+        if (opticalBands.empty()) {
+            if (band != 0) error("opticalBand needs to be 0 without opticalBands");
+            overallSpectrum = Spectrum({666e12});
+            opticalBandIndex = 0;
+        }
+        else {
+            if (band < 0 || band >= static_cast<int>(opticalBands.size())) error("opticalBand %d is not one of the %d opticalBands", band, static_cast<int>(opticalBands.size()));
+            double bandFrequency = opticalBands[band].getCenterFrequency();
+            // Frequencies of a Spectrum are ascending, keep the bands in the same order
+            std::sort(opticalBands.begin(), opticalBands.end(), [](const OpticalBand& a, const OpticalBand& b) {
+                return a.getCenterFrequency() < b.getCenterFrequency();
+            });
+            std::vector<double> frequencies;
+            for (auto& opticalBand : opticalBands) {
+                frequencies.push_back(opticalBand.getCenterFrequency());
+            }
+            overallSpectrum = Spectrum(frequencies);
+            opticalBandIndex = overallSpectrum.indexOf(bandFrequency);
+        }
     }
     BasePhyLayer::initialize(stage);
+    if (stage == 0) {
+        if (auto vlcConnectionManager = dynamic_cast<VlcConnectionManager*>(cc)) vlcConnectionManager->checkOpticalBands(opticalBands);
+        if (useLinkCache) extractLightModels();
+        initializeSingleCarrierModels();
+    }
 }
 
-unique_ptr<AnalogueModel> PhyLayerVlc::getAnalogueModelFromName(std::string name, ParameterMap& params)
+void PhyLayerVlc::finish()
+{
+    if (useLinkCache) {
+        recordScalar("linkCacheHits", linkCacheHits);
+        recordScalar("linkCacheMisses", linkCacheMisses);
+    }
+    if (senderSideCulling) {
+        recordScalar("senderSideCulledReceivers", culledReceivers);
+    }
+    for (auto& analogueModel : analogueModels) {
+        auto obstacleModel = dynamic_cast<VehicleObstacleShadowingForVlc*>(analogueModel.get());
+        if (obstacleModel && obstacleModel->getLosCacheHits() + obstacleModel->getLosCacheMisses() > 0) {
+            recordScalar("losCacheHits", obstacleModel->getLosCacheHits());
+            recordScalar("losCacheMisses", obstacleModel->getLosCacheMisses());
+        }
+    }
+    BasePhyLayer::finish();
+}
+
+void PhyLayerVlc::receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details)
+{
+    // BasePhyLayer updates the position in the connection manager, whose link predictions need the new velocity
+    if (signalID == BaseMobility::mobilityStateChangedSignal) {
+        ++mobilityEpoch;
+        if (auto* mobility = dynamic_cast<BaseMobility*>(obj)) {
+            velocity = mobility->getCurrentSpeed();
+        }
+    }
+    BasePhyLayer::receiveSignal(source, signalID, obj, details);
+}
+
+void PhyLayerVlc::extractLightModels()
+{
+    for (auto* models : {&analogueModels, &analogueModelsThresholding}) {
+        for (auto it = models->begin(); it != models->end();) {
+            if (dynamic_cast<EmpiricalLightModel*>(it->get()) || dynamic_cast<LsvLightModel*>(it->get())) {
+                lightModels.push_back(std::move(*it));
+                it = models->erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+}
+
+void PhyLayerVlc::initializeSingleCarrierModels()
+{
+    singleCarrierModels.clear();
+    singleCarrier = true;
+    for (auto* models : {&analogueModels, &analogueModelsThresholding}) {
+        for (auto& model : *models) {
+            auto* singleCarrierModel = dynamic_cast<SingleCarrierAnalogueModel*>(model.get());
+            if (!singleCarrierModel) {
+                singleCarrier = false;
+                singleCarrierModels.clear();
+                return;
+            }
+            singleCarrierModels.push_back(singleCarrierModel);
+        }
+    }
+}
+
+void PhyLayerVlc::filterSignal(AirFrame* frame)
+{
+    AirFrameVlc* frameVlc = check_and_cast<AirFrameVlc*>(frame);
+    PhyLayerVlc* senderPhy = dynamic_cast<PhyLayerVlc*>(frame->getSenderModule());
+    if (getNumApertures() > 1 || (senderPhy && senderPhy->getNumApertures() > 1)) {
+        filterSignalApertures(frameVlc, senderPhy);
+        return;
+    }
+
+    if (singleCarrier) {
+        POA receiverPoa = getAperturePoa(0);
+        applyReceivedPower(frameVlc, receiverPoa, calcReceivedPower(frameVlc, frame->getPoa(), receiverPoa, getLinkId(frame->getSenderModuleId())));
+        return;
+    }
+
+    // Antenna gains and all other analogue models
+    BasePhyLayer::filterSignal(frame);
+    if (lightModels.empty()) return;
+
+    Signal& signal = frame->getSignal();
+    signal *= getLightModelAttenuation(signal, signal.getSenderPoa(), signal.getReceiverPoa(), getLinkId(frame->getSenderModuleId()), frameVlc->getSenderMobilityEpoch());
+}
+
+void PhyLayerVlc::filterSignalApertures(AirFrameVlc* frame, PhyLayerVlc* senderPhy)
+{
+    // Selection combining: the frame is received on the aperture with the most power
+    int bestAperture = 0;
+    double bestPower = 0;
+    for (int aperture = 0; aperture < getNumApertures(); ++aperture) {
+        double power = getReceivedPower(frame, senderPhy, aperture);
+        if (power > bestPower) {
+            bestAperture = aperture;
+            bestPower = power;
+        }
+    }
+    frame->setRxAperture(bestAperture);
+    applyReceivedPower(frame, getAperturePoa(bestAperture), bestPower);
+}
+
+void PhyLayerVlc::applyReceivedPower(AirFrameVlc* frame, const POA& receiverPoa, double power)
+{
+    frame->setReceivedPower(power);
+
+    // All analogue models, including the thresholding ones, are already applied to the power. Scale the Signal
+    // in place to match it, so that everything working on the Signal, e.g., SignalUtils, still sees that power
+    Signal& signal = frame->getSignal();
+    signal.setSenderPoa(frame->getPoa());
+    signal.setReceiverPoa(receiverPoa);
+    double txPower = signal.getAtCenterFrequency();
+    signal *= (txPower > 0) ? power / txPower : 0;
+}
+
+double PhyLayerVlc::getReceivedPower(AirFrameVlc* frame, PhyLayerVlc* senderPhy, int rxAperture)
+{
+    const POA receiverPoa = getAperturePoa(rxAperture);
+    // The frame has no sender module yet while senderPhy culls its receivers
+    int senderId = senderPhy ? senderPhy->getId() : frame->getSenderModuleId();
+    if (!senderPhy || senderPhy->getNumApertures() == 1) {
+        return calcReceivedPower(frame, frame->getPoa(), receiverPoa, getLinkId(senderId, 0, rxAperture));
+    }
+
+    double power = 0;
+    for (int txAperture = 0; txAperture < senderPhy->getNumApertures(); ++txAperture) {
+        if (!(frame->getTxApertures() & (1 << txAperture))) continue;
+        power += calcReceivedPower(frame, senderPhy->getAperturePoa(txAperture), receiverPoa, getLinkId(senderId, txAperture, rxAperture));
+    }
+    return power;
+}
+
+double PhyLayerVlc::calcReceivedPower(AirFrameVlc* frame, const POA& senderPoa, const POA& receiverPoa, long linkId)
+{
+    const Coord senderPosition = senderPoa.pos.getPositionAt();
+    const Coord receiverPosition = receiverPoa.pos.getPositionAt();
+    double receiverGain = receiverPoa.antenna->getGain(receiverPosition, receiverPoa.orientation, senderPosition);
+    double senderGain = senderPoa.antenna->getGain(senderPosition, senderPoa.orientation, receiverPosition);
+
+    if (singleCarrier) {
+        // The power is a scalar: attenuate it directly instead of a copy of the Signal
+        const Signal& signal = frame->getSignal();
+        double power = signal.getAtCenterFrequency() * receiverGain * senderGain;
+        for (auto* model : singleCarrierModels) {
+            if (power == 0) return 0;
+            power *= model->getAttenuation(signal, senderPoa, receiverPoa);
+        }
+        if (power > 0 && !lightModels.empty()) {
+            power *= getLightModelAttenuation(signal, senderPoa, receiverPoa, linkId, frame->getSenderMobilityEpoch());
+        }
+        return power;
+    }
+
+    // Same as filterSignal, but on a copy of the Signal
+    Signal signal = frame->getSignal();
+    signal.setSenderPoa(senderPoa);
+    signal.setReceiverPoa(receiverPoa);
+    signal *= receiverGain * senderGain;
+
+    for (auto* models : {&analogueModels, &analogueModelsThresholding}) {
+        for (auto& analogueModel : *models) {
+            analogueModel->filterSignal(&signal);
+        }
+    }
+    if (!lightModels.empty()) {
+        signal *= getLightModelAttenuation(signal, senderPoa, receiverPoa, linkId, frame->getSenderMobilityEpoch());
+    }
+    return signal.getAtCenterFrequency();
+}
+
+POA PhyLayerVlc::getAperturePoa(int aperture) const
+{
+    ASSERT(aperture == 0);
+    return {antennaPosition, antennaHeading.toCoord(), antenna};
+}
+
+double PhyLayerVlc::getLightModelAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa, long linkId, long senderMobilityEpoch)
+{
+    // Any move of this NIC invalidates the attenuation of all links towards it
+    if (linkCacheEpoch != mobilityEpoch) {
+        linkCache.clear();
+        linkCacheEpoch = mobilityEpoch;
+    }
+
+    auto it = linkCache.find(linkId);
+    if (it != linkCache.end() && it->second.senderMobilityEpoch == senderMobilityEpoch && senderMobilityEpoch >= 0) {
+        ++linkCacheHits;
+        return it->second.attenuation;
+    }
+
+    ++linkCacheMisses;
+    double attenuation = calcLightModelAttenuation(signal, senderPoa, receiverPoa);
+    linkCache[linkId] = {senderMobilityEpoch, attenuation};
+    return attenuation;
+}
+
+bool PhyLayerVlc::isAboveMinPowerLevel(AirFrameVlc* frame, PhyLayerVlc* senderPhy)
+{
+    // Frames on other bands are filtered by the photodiode
+    if (frame->getSignal().getCenterFrequencyIndex() != opticalBandIndex) return false;
+
+    for (int aperture = 0; aperture < getNumApertures(); ++aperture) {
+        if (getReceivedPower(frame, senderPhy, aperture) >= minPowerLevel) return true;
+    }
+    return false;
+}
+
+void PhyLayerVlc::sendToChannel(cPacket* msg)
 {
+    if (!senderSideCulling || !useSendDirect) {
+        BasePhyLayer::sendToChannel(msg);
+        return;
+    }
+
+    AirFrameVlc* frame = check_and_cast<AirFrameVlc*>(msg);
+
+    // Only receivers which can detect the frame get a copy
+    std::vector<std::pair<const NicEntry*, cGate*>> receivers;
+    for (auto& entry : cc->getGateList(getId())) {
+        PhyLayerVlc* receiverPhy = dynamic_cast<PhyLayerVlc*>(entry.second->getOwnerModule());
+        if (receiverPhy && !receiverPhy->isAboveMinPowerLevel(frame, this)) {
+            ++culledReceivers;
+            continue;
+        }
+        receivers.push_back(entry);
+    }
+
+    if (receivers.empty()) {
+        EV_TRACE << "No receiver can detect AirFrame w/ id: " << frame->getId() << std::endl;
+        delete msg;
+        return;
+    }
 
-    if (name == "EmpiricalLightModel") {
-        return initializeEmpiricalLightModel(params);
+    // Copies share the encapsulated MacPkt (cPacket reference counting) until a receiver decapsulates it,
+    // i.e., only frames which are decoded get their own payload. Nothing on the way to the decider may
+    // call getEncapsulatedPacket(), which would copy it for every receiver.
+    for (size_t i = 0; i < receivers.size(); ++i) {
+        const NicEntry* nic = receivers[i].first;
+        cGate* gate = receivers[i].second;
+        simtime_t delay = calculatePropagationDelay(nic);
+
+        // the last receiver gets the original frame
+        bool last = i + 1 == receivers.size();
+        sendDirect(last ? msg : msg->dup(), delay, msg->getDuration(), gate);
     }
-    else if (name == "LsvLightModel") {
-        return initializeLsvLightModel(params);
+}
+
+double PhyLayerVlc::calcLightModelAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa)
+{
+    double attenuation = 1;
+    for (auto& model : lightModels) {
+        if (attenuation == 0) break;
+        attenuation *= dynamic_cast<SingleCarrierAnalogueModel&>(*model).getAttenuation(signal, senderPoa, receiverPoa);
+    }
+    return attenuation;
+}
+
+unique_ptr<AnalogueModel> PhyLayerVlc::getAnalogueModelFromName(std::string name, ParameterMap& params)
+{
+
+    if (name == "EmpiricalLightModel" || name == "LsvLightModel") {
+        // Parsed once per configuration, each NIC gets its own instance
+        std::string key = getPrototypeKey(name, params);
+        auto prototype = lightModelPrototypes.get(key, [&]() {
+            auto parsed = (name == "EmpiricalLightModel") ? initializeEmpiricalLightModel(params) : initializeLsvLightModel(params);
+            return std::make_shared<AnalogueModelPrototype>(std::move(parsed));
+        });
+        lightModelKey += key + ";";
+        return (*prototype)(this);
     }
     else if (name == "VehicleObstacleShadowingForVlc") {
         return initializeVehicleObstacleShadowingForVlc(params);
@@ -73,7 +376,7 @@ unique_ptr<AnalogueModel> PhyLayerVlc::getAnalogueModelFromName(std::string name
     return BasePhyLayer::getAnalogueModelFromName(name, params);
 }
 
-unique_ptr<AnalogueModel> PhyLayerVlc::initializeEmpiricalLightModel(ParameterMap& params)
+PhyLayerVlc::AnalogueModelPrototype PhyLayerVlc::initializeEmpiricalLightModel(ParameterMap& params)
 {
 
     double headlightMaxTxRange = 0.0, taillightMaxTxRange = 0.0, headlightMaxTxAngle = 0.0, taillightMaxTxAngle = 0.0;
@@ -111,11 +414,14 @@ unique_ptr<AnalogueModel> PhyLayerVlc::initializeEmpiricalLightModel(ParameterMa
         error("`taillightMaxTxAngle` has not been specified in config-vlc.xml");
     }
 
-    return make_unique<EmpiricalLightModel>(this, FWMath::mW2dBm(minPowerLevel), headlightMaxTxRange, taillightMaxTxRange, headlightMaxTxAngle, taillightMaxTxAngle);
+    double sensitivity_dbm = FWMath::mW2dBm(minPowerLevel);
+    return [=](cComponent* owner) -> unique_ptr<AnalogueModel> {
+        return make_unique<EmpiricalLightModel>(owner, sensitivity_dbm, headlightMaxTxRange, taillightMaxTxRange, headlightMaxTxAngle, taillightMaxTxAngle);
+    };
 }
 
 // version using line-by-line parsing
-unique_ptr<AnalogueModel> PhyLayerVlc::initializeLsvLightModel(ParameterMap& params)
+PhyLayerVlc::AnalogueModelPrototype PhyLayerVlc::initializeLsvLightModel(ParameterMap& params)
 {
     if (mapsInitialized == false) {
 
@@ -175,6 +481,7 @@ unique_ptr<AnalogueModel> PhyLayerVlc::initializeLsvLightModel(ParameterMap& par
                 break;
             case 5:
                 while (iss >> value) spectralEmission.push_back(value);
+                if (static_cast<int>(spectralEmission.size()) != SPECTRAL_SAMPLES) error("Spectral emission of radiation pattern %s in %s has %d instead of %d samples", Id.c_str(), radiationPatternFile.c_str(), static_cast<int>(spectralEmission.size()), SPECTRAL_SAMPLES);
                 lineCounter = 0;
                 radiationPatternMap.insert(std::pair<std::string, RadiationPattern>(Id, RadiationPattern(Id, patternL, patternR, anglesL, anglesR, spectralEmission)));
                 // Clear all vectors for next pattern
@@ -213,6 +520,7 @@ unique_ptr<AnalogueModel> PhyLayerVlc::initializeLsvLightModel(ParameterMap& par
                 break;
             case 3:
                 while (iss >> value) spectralResponse.push_back(value);
+                if (static_cast<int>(spectralResponse.size()) != SPECTRAL_SAMPLES) error("Spectral response of photodiode %s in %s has %d instead of %d samples", Id.c_str(), photodiodeFile.c_str(), static_cast<int>(spectralResponse.size()), SPECTRAL_SAMPLES);
                 lineCounter = 0;
                 photodiodeMap.insert(std::pair<std::string, Photodiode>(Id, Photodiode(Id, area, gain, spectralResponse)));
                 spectralResponse.clear();
@@ -222,7 +530,72 @@ unique_ptr<AnalogueModel> PhyLayerVlc::initializeLsvLightModel(ParameterMap& par
         }
         mapsInitialized = true;
     }
-    return make_unique<LsvLightModel>(this, &radiationPatternMap, &photodiodeMap, FWMath::mW2dBm(minPowerLevel));
+    double sensitivity_dbm = FWMath::mW2dBm(minPowerLevel);
+    std::vector<OpticalBand> bands = opticalBands;
+    return [=](cComponent* owner) -> unique_ptr<AnalogueModel> {
+        return make_unique<LsvLightModel>(owner, &radiationPatternMap, &photodiodeMap, sensitivity_dbm, bands);
+    };
+}
+
+int PhyLayerVlc::getLightingModuleOrientation() const
+{
+    if (dynamic_cast<AntennaHeadlight*>(antenna.get())) {
+        return HEAD;
+    }
+    if (dynamic_cast<AntennaTaillight*>(antenna.get())) {
+        return TAIL;
+    }
+    throw cRuntimeError("PhyLayerVlc only knows about HeadlightAntenna and TaillightAntenna");
+}
+
+Coord PhyLayerVlc::getTxDirection() const
+{
+    // Same heading vector as computed by the light models
+    double txHeading = traci2myAngle(antennaHeading.getRad());
+    return Coord(cos(txHeading), sin(txHeading)) * getLightingModuleOrientation();
+}
+
+const TxCone& PhyLayerVlc::getTxCone()
+{
+    if (!txConeInitialized) {
+        txCone = calcTxCone();
+        txConeInitialized = true;
+    }
+    return txCone;
+}
+
+TxCone PhyLayerVlc::calcTxCone()
+{
+    return calcApertureTxCone(*check_and_cast<AntennaVlc*>(antenna.get()), getLightingModuleOrientation());
+}
+
+TxCone PhyLayerVlc::calcApertureTxCone(const AntennaVlc& txAntenna, int txOrientation)
+{
+    // Same light models and light module, same cone
+    if (!lightModelKey.empty()) {
+        std::string key = lightModelKey + getAntennaKey(txOrientation, txAntenna.photodiodeGroundOffsetZ, txAntenna.interModuleDistance, txAntenna.radiationPatternId, txAntenna.photodiodeId);
+        auto cone = txConePrototypes.get(key, [&]() {
+            return std::make_shared<TxCone>(calcUncachedTxCone(txAntenna, txOrientation));
+        });
+        return *cone;
+    }
+    return calcUncachedTxCone(txAntenna, txOrientation);
+}
+
+TxCone PhyLayerVlc::calcUncachedTxCone(const AntennaVlc& txAntenna, int txOrientation)
+{
+    // The analogue models are multiplied, so the cone of any light model bounds the total
+    for (auto* models : {&lightModels, &analogueModels, &analogueModelsThresholding}) {
+        for (auto& model : *models) {
+            if (auto* elm = dynamic_cast<EmpiricalLightModel*>(model.get())) {
+                return elm->getTxCone(txOrientation);
+            }
+            if (auto* lsv = dynamic_cast<LsvLightModel*>(model.get())) {
+                return lsv->getTxCone(txAntenna);
+            }
+        }
+    }
+    return TxCone();
 }
 
 unique_ptr<Decider> PhyLayerVlc::getDeciderFromName(std::string name, ParameterMap& params)
@@ -258,7 +631,7 @@ std::shared_ptr<Antenna> PhyLayerVlc::initializeAntennaHeadlight(ParameterMap& p
     std::string radiationPatternId = par("radiationPatternId");
     std::string photodiodeId = par("photodiodeId");
 
-    return std::make_shared<AntennaHeadlight>(photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
+    return getAntennaPrototype(HEAD, photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
 }
 
 std::shared_ptr<Antenna> PhyLayerVlc::initializeAntennaTaillight(ParameterMap& params)
@@ -268,7 +641,34 @@ std::shared_ptr<Antenna> PhyLayerVlc::initializeAntennaTaillight(ParameterMap& p
     std::string radiationPatternId = par("radiationPatternId");
     std::string photodiodeId = par("photodiodeId");
 
-    return std::make_shared<AntennaTaillight>(photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
+    return getAntennaPrototype(TAIL, photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
+}
+
+std::string PhyLayerVlc::getAntennaKey(int orientation, double photodiodeGroundOffsetZ, double interModuleDistance, const std::string& radiationPatternId, const std::string& photodiodeId)
+{
+    std::ostringstream key;
+    key << std::setprecision(17) << ((orientation == HEAD) ? "head" : "tail") << " " << photodiodeGroundOffsetZ << " " << interModuleDistance << " " << radiationPatternId << " " << photodiodeId;
+    return key.str();
+}
+
+std::shared_ptr<Antenna> PhyLayerVlc::getAntennaPrototype(int orientation, double photodiodeGroundOffsetZ, double interModuleDistance, const std::string& radiationPatternId, const std::string& photodiodeId)
+{
+    std::string key = getAntennaKey(orientation, photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
+    return antennaPrototypes.get(key, [&]() -> std::shared_ptr<Antenna> {
+        if (orientation == HEAD) return std::make_shared<AntennaHeadlight>(photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
+        return std::make_shared<AntennaTaillight>(photodiodeGroundOffsetZ, interModuleDistance, radiationPatternId, photodiodeId);
+    });
+}
+
+std::string PhyLayerVlc::getPrototypeKey(const std::string& name, const ParameterMap& params)
+{
+    // Besides their XML parameters, the light models are created from the sensitivity and the optical bands
+    std::ostringstream key;
+    key << std::setprecision(17) << name << " minPowerLevel=" << minPowerLevel << " opticalBands=" << par("opticalBands").stdstringValue();
+    for (auto& param : params) {
+        key << " " << param.first << "=" << param.second.str();
+    }
+    return key.str();
 }
 
 unique_ptr<AnalogueModel> PhyLayerVlc::initializeVehicleObstacleShadowingForVlc(ParameterMap& params)
@@ -277,17 +677,58 @@ unique_ptr<AnalogueModel> PhyLayerVlc::initializeVehicleObstacleShadowingForVlc(
     bool useTorus = world->useTorus();
     const Coord& playgroundSize = *(world->getPgs());
 
+    bool useLaneIndex = false;
+    ParameterMap::iterator it = params.find("useLaneIndex");
+    if (it != params.end()) {
+        useLaneIndex = it->second.boolValue();
+    }
+
+    bool useLosCache = false;
+    it = params.find("useLosCache");
+    if (it != params.end()) {
+        useLosCache = it->second.boolValue();
+    }
+
+    bool useVehicleBoxes = false;
+    it = params.find("useVehicleBoxes");
+    if (it != params.end()) {
+        useVehicleBoxes = it->second.boolValue();
+    }
+
     VehicleObstacleControl* vehicleObstacleControlP = VehicleObstacleControlAccess().getIfExists();
     if (!vehicleObstacleControlP) throw cRuntimeError("initializeVehicleObstacleShadowingForVlc(): cannot find VehicleObstacleControl module");
-    return make_unique<VehicleObstacleShadowingForVlc>(this, *vehicleObstacleControlP, useTorus, playgroundSize);
+    return make_unique<VehicleObstacleShadowingForVlc>(this, *vehicleObstacleControlP, useTorus, playgroundSize, useLaneIndex, useLosCache, useVehicleBoxes);
 }
 
 unique_ptr<Decider> PhyLayerVlc::initializeDeciderVlc(ParameterMap& params)
 {
-    DeciderVlc* dec = new DeciderVlc(this, this, minPowerLevel, bitrate, findHost()->getIndex(), collectCollisionStatistics);
+    DeciderVlc* dec = new DeciderVlc(this, this, minPowerLevel, bitrate, findHost()->getIndex(), collectCollisionStatistics, fullDuplex, opticalBandIndex, 0, usePdrTable);
+    initializeDecodingMode(*dec, params);
     return unique_ptr<DeciderVlc>(std::move(dec));
 }
 
+void PhyLayerVlc::initializeDecodingMode(DeciderVlc& decider, ParameterMap& params)
+{
+    std::string decodingMode = "probabilistic";
+    ParameterMap::iterator it = params.find("decodingMode");
+    if (it != params.end()) {
+        decodingMode = it->second.stringValue();
+    }
+
+    if (decodingMode == "threshold") {
+        double targetPdr = 0.9;
+        it = params.find("targetPdr");
+        if (it != params.end()) {
+            targetPdr = it->second.doubleValue();
+        }
+        if (targetPdr <= 0 || targetPdr >= 1) error("`targetPdr` of the DeciderVlc needs to be in (0, 1)");
+        decider.setThresholdDecoding(targetPdr);
+    }
+    else if (decodingMode != "probabilistic") {
+        error("Unknown `decodingMode` of the DeciderVlc: %s", decodingMode.c_str());
+    }
+}
+
 void PhyLayerVlc::handleMessage(cMessage* msg)
 {
     // self messages
@@ -310,8 +751,9 @@ void PhyLayerVlc::handleMessage(cMessage* msg)
     }
     else if (msg->getKind() == AIR_FRAME) {
         AirFrameVlc* VlcMsg = check_and_cast<AirFrameVlc*>(msg);
-        std::string txNode = VlcMsg->getSenderModule()->getModuleByPath("^.^.")->getFullName();
-        if (txNode == getModuleByPath("^.^.")->getFullName()) {
+        // VlcConnectionManager does not connect NICs of the same host, this is just a safety net
+        PhyLayerVlc* senderPhy = dynamic_cast<PhyLayerVlc*>(VlcMsg->getSenderModule());
+        if (senderPhy && senderPhy->getHostId() == hostId) {
             EV_TRACE << "Discarding received AirFrameVlc within the same host: " << VlcMsg->getSenderModule()->getFullPath() << std::endl;
             delete msg;
             return;
@@ -349,19 +791,31 @@ unique_ptr<AirFrame> PhyLayerVlc::encapsMsg(cPacket* macPkt)
     frame->setProtocolId(myProtocolId());
     frame->setId(world->getUniqueAirFrameId());
     frame->setChannel(radio->getCurrentChannel());
+    frame->setSenderMobilityEpoch(mobilityEpoch);
+    // all apertures emit the frame unless the MAC selected some of them
+    int allApertures = (1 << getNumApertures()) - 1;
+    frame->setTxApertures(allApertures);
+    if (auto macPktVlc = dynamic_cast<MacPktVlc*>(macPkt)) {
+        frame->setPhyMode(macPktVlc->getPhyMode());
+        if (getNumApertures() > 1 && macPktVlc->getTxApertures() != -1) {
+            frame->setTxApertures(macPktVlc->getTxApertures() & allApertures);
+            if (frame->getTxApertures() == 0) throw cRuntimeError("MacPktVlc selects none of the %d apertures", getNumApertures());
+        }
+    }
 
     // encapsulate the mac packet into the phy frame
     frame->encapsulate(macPkt);
 
     // attachSignal()
     // attach the spectrum-dependent Signal to the airFrame
-    const auto duration = getFrameDuration(frame->getEncapsulatedPacket()->getBitLength());
+    const auto duration = getFrameDuration(frame->getEncapsulatedPacket()->getBitLength(), frame->getPhyMode());
     ASSERT(duration > 0);
+    if (!fullDuplex) setTransmissionEnd(simTime() + duration);
     Signal signal(overallSpectrum, simTime(), duration);
-    signal.at(0) = txPower;
-    signal.setDataStart(0);
-    signal.setDataEnd(0);
-    signal.setCenterFrequencyIndex(0);
+    signal.at(opticalBandIndex) = txPower;
+    signal.setDataStart(opticalBandIndex);
+    signal.setDataEnd(opticalBandIndex);
+    signal.setCenterFrequencyIndex(opticalBandIndex);
     // copy the signal into the AirFrame
     frame->setSignal(signal);
     frame->setDuration(signal.getDuration());
@@ -374,17 +828,24 @@ unique_ptr<AirFrame> PhyLayerVlc::encapsMsg(cPacket* macPkt)
     return airFrame;
 }
 
+void PhyLayerVlc::setTransmissionEnd(simtime_t end)
+{
+    check_and_cast<DeciderVlc*>(decider.get())->setTransmissionEnd(end);
+}
+
 simtime_t PhyLayerVlc::setRadioState(int rs)
 {
     if (rs == Radio::TX) decider->switchToTx();
     return BasePhyLayer::setRadioState(rs);
 }
 
-simtime_t PhyLayerVlc::getFrameDuration(int payloadLengthBits) const
+simtime_t PhyLayerVlc::getFrameDuration(int payloadLengthBits, int phyMode) const
 {
     // Following assumptions apply:
     // i) The SHR and the HEADER are sent with the same bitrate as the payload
     // ii) Due to OOK, the number of bits per symbol (n_nbps) == 1, so the payload is not divided
-    simtime_t duration = (PHY_VLC_SHR + PHY_VLC_HEADER) / bitrate + payloadLengthBits / bitrate;
+    // iii) With an operating mode, its data rate already accounts for the line and FEC codes
+    double rate = (phyMode == -1) ? bitrate : getVlcPhyMode(phyMode).getDataRate();
+    simtime_t duration = (PHY_VLC_SHR + PHY_VLC_HEADER) / rate + payloadLengthBits / rate;
     return duration;
 }
@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "veins/base/phyLayer/BasePhyLayer.h"
 #include "veins/base/toolbox/Spectrum.h"
 #include "veins/modules/mac/ieee80211p/Mac80211pToPhy11pInterface.h"
@@ -33,8 +35,14 @@
 #include "veins-vlc/utility/ConstsVlc.h"
 
 #include "veins-vlc/analogueModel/LsvLightModel.h"
+#include "veins-vlc/analogueModel/SingleCarrierAnalogueModel.h"
 #include "veins-vlc/RadiationPattern.h"
 #include "veins-vlc/Photodiode.h"
+#include "veins-vlc/AntennaVlc.h"
+#include "veins-vlc/utility/TxCone.h"
+#include "veins-vlc/utility/OpticalBand.h"
+#include "veins-vlc/utility/PrototypeRegistry.h"
+#include "veins-vlc/messages/AirFrameVlc_m.h"
 
 namespace veins {
 
@@ -53,12 +61,138 @@ namespace veins {
 class PhyLayerVlc : public BasePhyLayer {
 public:
     void initialize(int stage) override;
+    void finish() override;
+
+    /**
+     * @brief Counts the mobility updates of this NIC, invalidating the link
+     * cache, and keeps track of its velocity.
+     */
+    void receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details) override;
+    using BasePhyLayer::receiveSignal;
+
+    /**
+     * @brief Returns the velocity of this NIC as of its last mobility update
+     */
+    const Coord& getVelocity() const
+    {
+        return velocity;
+    }
+
+    int getHostId() const
+    {
+        return hostId;
+    }
+
+    /**
+     * @brief Returns the bitrate of frames sent without an operating mode,
+     * which is also the receiver bandwidth the noise floor refers to
+     */
+    double getBitrate() const
+    {
+        return bitrate;
+    }
+
+    /**
+     * @brief Returns the number of mobility updates of this NIC so far;
+     * the geometry of its links only changes with it
+     */
+    long getMobilityEpoch() const
+    {
+        return mobilityEpoch;
+    }
 
     static bool mapsInitialized;
     static std::map<std::string, RadiationPattern> radiationPatternMap;
     static std::map<std::string, Photodiode> photodiodeMap;
 
+    /**
+     * @brief Returns the orientation of the light module of this NIC,
+     * i.e., HEAD or TAIL
+     */
+    int getLightingModuleOrientation() const;
+
+    /**
+     * @brief Returns the unit vector (in the x-y plane) of the direction
+     * the light module of this NIC is facing
+     */
+    Coord getTxDirection() const;
+
+    /**
+     * @brief Returns the region outside of which the analogue models
+     * attenuate transmissions of this NIC to zero
+     */
+    const TxCone& getTxCone();
+
+    /**
+     * @brief Returns the number of apertures (light module and
+     * photodiode pairs) of this NIC
+     */
+    virtual int getNumApertures() const
+    {
+        return 1;
+    }
+
+    /**
+     * @brief Returns the current position, orientation and antenna of
+     * the given aperture of this NIC
+     */
+    virtual POA getAperturePoa(int aperture) const;
+
 protected:
+    /** @brief Whether txCone has been derived from the analogue models yet */
+    bool txConeInitialized = false;
+
+    /** @brief Cached result of getTxCone() */
+    TxCone txCone;
+
+    /** @brief Cached attenuation of the light models for one sender */
+    struct LinkCacheEntry {
+        long senderMobilityEpoch;
+        double attenuation;
+    };
+
+    /** @brief Velocity of the host as of the last mobility update */
+    Coord velocity;
+
+    /** @brief Number of mobility updates of this NIC so far */
+    long mobilityEpoch = 0;
+
+    /** @brief Whether to cache the attenuation of the light models */
+    bool useLinkCache;
+
+    /** @brief Light models, moved out of the analogue model lists if useLinkCache is enabled */
+    AnalogueModelList lightModels;
+
+    /** @brief Whether all analogue models are SingleCarrierAnalogueModels, see calcReceivedPower */
+    bool singleCarrier = false;
+
+    /** @brief The analogue models, including the thresholding ones, if singleCarrier */
+    std::vector<SingleCarrierAnalogueModel*> singleCarrierModels;
+
+    /** @brief Attenuation of lightModels per link (see getLinkId), valid for linkCacheEpoch */
+    std::map<long, LinkCacheEntry> linkCache;
+
+    /** @brief mobilityEpoch for which linkCache is valid */
+    long linkCacheEpoch = 0;
+
+    long linkCacheHits = 0;
+    long linkCacheMisses = 0;
+
+    /** @brief Id of the host module, e.g., to discard frames of other NICs of the same host */
+    int hostId;
+
+    /** @brief Whether the NIC keeps receiving while transmitting */
+    bool fullDuplex;
+
+    /** @brief Whether the decider looks up the PDR of OOK frames in an OokPdrTable */
+    bool usePdrTable;
+
+    /** @brief Whether to only send to receivers which can detect a frame */
+    bool senderSideCulling;
+
+    /** @brief Number of receivers which have not been sent a frame due to senderSideCulling */
+    long culledReceivers = 0;
+
     /** @brief enable/disable detection of packet collisions */
     bool collectCollisionStatistics;
 
@@ -67,9 +201,47 @@ protected:
 
     double bitrate;
 
+    /** @brief Bands of the frequencies of overallSpectrum, empty for a single band of white light */
+    std::vector<OpticalBand> opticalBands;
+    /** @brief Frequency index of the band this NIC sends and receives on */
+    size_t opticalBandIndex;
+
     enum ProtocolIds {
         VLC = 12124
     };
+
+    /** @brief Creates a light model for the given owner from its parsed configuration */
+    using AnalogueModelPrototype = std::function<std::unique_ptr<AnalogueModel>(cComponent* owner)>;
+
+    /** @brief Parsed light models, keyed by getPrototypeKey() */
+    static PrototypeRegistry<AnalogueModelPrototype> lightModelPrototypes;
+    /** @brief Antennas shared by all light modules with the same parameters, keyed by getAntennaKey() */
+    static PrototypeRegistry<Antenna> antennaPrototypes;
+    /** @brief Cones derived from the light models, keyed by lightModelKey and getAntennaKey() */
+    static PrototypeRegistry<TxCone> txConePrototypes;
+
+    /** @brief Prototype keys of the light models of this NIC */
+    std::string lightModelKey;
+
+    /**
+     * @brief Returns the key of the prototype of the analogue model with
+     * the given name and parameters, including the parameters of this
+     * NIC it is created from
+     */
+    std::string getPrototypeKey(const std::string& name, const ParameterMap& params);
+
+    /**
+     * @brief Returns the key of the antenna of a light module with the
+     * given orientation (HEAD or TAIL) and parameters
+     */
+    static std::string getAntennaKey(int orientation, double photodiodeGroundOffsetZ, double interModuleDistance, const std::string& radiationPatternId, const std::string& photodiodeId);
+
+    /**
+     * @brief Returns the antenna of a light module with the given
+     * orientation and parameters, shared with all other light modules
+     * with the same ones; antennas are immutable
+     */
+    static std::shared_ptr<Antenna> getAntennaPrototype(int orientation, double photodiodeGroundOffsetZ, double interModuleDistance, const std::string& radiationPatternId, const std::string& photodiodeId);
     /**
      * @brief Creates and returns an instance of the AnalogueModel with the
      * specified name.
@@ -85,16 +257,16 @@ protected:
     std::unique_ptr<AnalogueModel> initializeVehicleObstacleShadowingForVlc(ParameterMap& params);
 
     /**
-     * @brief Creates and initializes a EmpiricalLightModel with the
-     * passed parameter values.
+     * @brief Parses the passed parameter values of a EmpiricalLightModel
+     * into a prototype.
      */
-    std::unique_ptr<AnalogueModel> initializeEmpiricalLightModel(ParameterMap& params);
+    AnalogueModelPrototype initializeEmpiricalLightModel(ParameterMap& params);
 
     /**
-     * @brief Creates and initializes a LsvLightModel with the
-     * passed parameter values.
+     * @brief Parses the passed parameter values of a LsvLightModel
+     * into a prototype.
      */
-    std::unique_ptr<AnalogueModel> initializeLsvLightModel(ParameterMap& params);
+    AnalogueModelPrototype initializeLsvLightModel(ParameterMap& params);
 
     /**
      * Create and return an instance of the Antenna with the specified name as a shared pointer.
@@ -119,6 +291,12 @@ protected:
      */
     virtual std::unique_ptr<Decider> initializeDeciderVlc(ParameterMap& params);
 
+    /**
+     * @brief Sets the decodingMode of the passed parameter values
+     * ("probabilistic" or "threshold" with a targetPdr) on decider
+     */
+    void initializeDecodingMode(DeciderVlc& decider, ParameterMap& params);
+
     /**
      * Create a protocol-specific AirFrame
      * Overloaded to create a specialize AirFrameVlc.
@@ -131,11 +309,116 @@ protected:
      */
     virtual std::unique_ptr<AirFrame> encapsMsg(cPacket* msg) override;
 
-    simtime_t getFrameDuration(int payloadLengthBits) const;
+    /**
+     * @brief Returns the duration of a frame, sent with the given
+     * operating mode, or with OOK at bitrate if phyMode is -1
+     */
+    simtime_t getFrameDuration(int payloadLengthBits, int phyMode = -1) const;
 
     virtual void handleMessage(cMessage* msg) override;
     simtime_t setRadioState(int rs) override;
 
+    /**
+     * @brief Applies the analogue models to the Signal of the frame,
+     * taking the attenuation of the light models from the link cache
+     */
+    void filterSignal(AirFrame* frame) override;
+
+    /**
+     * @brief Applies the analogue models to the Signal of a frame sent or
+     * received by a NIC with several apertures: the light of all sending
+     * apertures adds up at each photodiode, and the frame is received on
+     * the aperture which gets the most power
+     */
+    void filterSignalApertures(AirFrameVlc* frame, PhyLayerVlc* senderPhy);
+
+    /**
+     * @brief Stores power as the received power of frame, scaling its
+     * Signal to match
+     */
+    void applyReceivedPower(AirFrameVlc* frame, const POA& receiverPoa, double power);
+
+    /**
+     * @brief Returns the power (in mW) of frame at the given aperture of
+     * this NIC, summed over the sending apertures of senderPhy
+     */
+    double getReceivedPower(AirFrameVlc* frame, PhyLayerVlc* senderPhy, int rxAperture);
+
+    /**
+     * @brief Returns the power (in mW) of frame received from senderPoa
+     * at receiverPoa after all analogue models
+     *
+     * If singleCarrier, the power is attenuated as a scalar, otherwise
+     * a copy of the Signal of frame is filtered.
+     */
+    double calcReceivedPower(AirFrameVlc* frame, const POA& senderPoa, const POA& receiverPoa, long linkId);
+
+    /**
+     * @brief Returns the key of the link from the given aperture of the
+     * NIC with senderId to the given aperture of this NIC
+     */
+    static long getLinkId(int senderId, int txAperture = 0, int rxAperture = 0)
+    {
+        return (static_cast<long>(senderId) << 8) | (txAperture << 4) | rxAperture;
+    }
+
+    /**
+     * @brief Returns the attenuation factor of lightModels for the link
+     * linkId, taken from the link cache if possible
+     */
+    double getLightModelAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa, long linkId, long senderMobilityEpoch);
+
+    /**
+     * @brief Returns whether this NIC would receive the frame about to be
+     * sent by senderPhy with at least minPowerLevel
+     */
+    bool isAboveMinPowerLevel(AirFrameVlc* frame, PhyLayerVlc* senderPhy);
+
+    /**
+     * @brief Sends the frame to all connected NICs, or, if senderSideCulling
+     * is enabled, only to those which can detect it
+     */
+    void sendToChannel(cPacket* msg) override;
+
+    /**
+     * @brief Moves the light models out of the analogue model lists into lightModels
+     */
+    void extractLightModels();
+
+    /**
+     * @brief Sets singleCarrier and singleCarrierModels from the
+     * analogue model lists
+     */
+    void initializeSingleCarrierModels();
+
+    /**
+     * @brief Returns the attenuation factor of lightModels from senderPoa
+     * to receiverPoa
+     */
+    double calcLightModelAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa);
+
+    /**
+     * @brief Derives the region illuminated by this NIC from the
+     * light models among its analogue models.
+     */
+    virtual TxCone calcTxCone();
+
+    /**
+     * @brief Derives the region illuminated by a light module with the
+     * given antenna and orientation (HEAD or TAIL) from the light models,
+     * taken from txConePrototypes if possible
+     */
+    TxCone calcApertureTxCone(const AntennaVlc& txAntenna, int txOrientation);
+
+    /** @brief calcApertureTxCone without txConePrototypes */
+    TxCone calcUncachedTxCone(const AntennaVlc& txAntenna, int txOrientation);
+
+    /**
+     * @brief Unless in full-duplex mode, tells the decider about the end
+     * of the transmission just started
+     */
+    virtual void setTransmissionEnd(simtime_t end);
+
     std::shared_ptr<Antenna> initializeAntennaHeadlight(ParameterMap& params);
     std::shared_ptr<Antenna> initializeAntennaTaillight(ParameterMap& params);
 };
@@ -0,0 +1,82 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/PhyLayerVlcVehicle.h"
+
+#include "veins-vlc/AntennaHeadlight.h"
+#include "veins-vlc/DeciderVlcApertures.h"
+
+#include <algorithm>
+
+using namespace veins;
+
+Define_Module(veins::PhyLayerVlcVehicle);
+
+void PhyLayerVlcVehicle::initialize(int stage)
+{
+    PhyLayerVlc::initialize(stage);
+    if (stage == 0) {
+        if (!dynamic_cast<AntennaHeadlight*>(antenna.get())) error("PhyLayerVlcVehicle needs a HeadlightAntenna");
+
+        double interModuleDistance = par("interModuleDistance");
+        std::string taillightRadiationPatternId = par("taillightRadiationPatternId");
+        std::string taillightPhotodiodeId = par("taillightPhotodiodeId");
+        auto taillightAntenna = getAntennaPrototype(TAIL, par("taillightPhotodiodeGroundOffsetZ").doubleValue(), interModuleDistance, taillightRadiationPatternId, taillightPhotodiodeId);
+
+        apertures.resize(2);
+        apertures[APERTURE_HEAD] = {antenna, HEAD, par("headlightOffsetX"), par("headlightOffsetZ")};
+        apertures[APERTURE_TAIL] = {taillightAntenna, TAIL, par("taillightOffsetX"), par("taillightOffsetZ")};
+    }
+}
+
+POA PhyLayerVlcVehicle::getAperturePoa(int aperture) const
+{
+    const Aperture& a = apertures.at(aperture);
+    const Coord heading = antennaHeading.toCoord();
+    Coord position = antennaPosition.getPositionAt() + heading * a.offsetX + Coord(0, 0, a.offsetZ);
+    return {AntennaPosition(getId(), position, velocity, simTime()), heading, a.antenna};
+}
+
+TxCone PhyLayerVlcVehicle::calcTxCone()
+{
+    TxCone cone;
+    cone.range = 0;
+    for (auto& a : apertures) {
+        TxCone apertureCone = calcApertureTxCone(*check_and_cast<AntennaVlc*>(a.antenna.get()), a.orientation);
+        cone.range = std::max(cone.range, apertureCone.range + std::fabs(a.offsetX));
+    }
+    return cone;
+}
+
+std::unique_ptr<Decider> PhyLayerVlcVehicle::initializeDeciderVlc(ParameterMap& params)
+{
+    std::vector<std::unique_ptr<DeciderVlc>> deciders;
+    for (int aperture : {APERTURE_HEAD, APERTURE_TAIL}) {
+        deciders.emplace_back(new DeciderVlc(this, this, minPowerLevel, bitrate, findHost()->getIndex(), collectCollisionStatistics, fullDuplex, opticalBandIndex, aperture, usePdrTable));
+        initializeDecodingMode(*deciders.back(), params);
+        deciders.back()->setStatisticsPrefix(aperture == APERTURE_HEAD ? "headlight" : "taillight");
+    }
+    return std::unique_ptr<Decider>(new DeciderVlcApertures(this, this, std::move(deciders)));
+}
+
+void PhyLayerVlcVehicle::setTransmissionEnd(simtime_t end)
+{
+    check_and_cast<DeciderVlcApertures*>(decider.get())->setTransmissionEnd(end);
+}
@@ -0,0 +1,89 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "veins-vlc/PhyLayerVlc.h"
+
+namespace veins {
+
+/**
+ * @brief PhyLayerVlc serving both the head and the tail light module
+ * (and the front and rear photodiode) of a vehicle
+ *
+ * Compared to one NicVlc per light module, the vehicle registers one
+ * NIC with the connection manager and each frame is sent once per
+ * pair of vehicles. The channel of every pair of apertures is still
+ * evaluated separately: the light of the sending apertures adds up at
+ * each photodiode, and the frame is received on the photodiode which
+ * gets the most power (selection combining), each with its own
+ * DeciderVlc.
+ *
+ * The apertures are offset from the position of the NIC along the
+ * heading of the vehicle. The antenna of the PhyLayerVlc needs to be
+ * a HeadlightAntenna, the TaillightAntenna is created from the
+ * taillight parameters.
+ *
+ * @see DeciderVlcApertures
+ */
+class PhyLayerVlcVehicle : public PhyLayerVlc {
+public:
+    void initialize(int stage) override;
+
+    /** @brief Head and tail */
+    int getNumApertures() const override
+    {
+        return 2;
+    }
+
+    POA getAperturePoa(int aperture) const override;
+
+protected:
+    struct Aperture {
+        std::shared_ptr<Antenna> antenna;
+        /** @brief HEAD or TAIL */
+        int orientation;
+        /** @brief Offset from the position of the NIC in m, along its heading */
+        double offsetX;
+        /** @brief Offset from the position of the NIC in m, upwards */
+        double offsetZ;
+    };
+
+    /** @brief Apertures of the vehicle, indexed by APERTURE_HEAD and APERTURE_TAIL */
+    std::vector<Aperture> apertures;
+
+    /**
+     * @brief The union of the cones of all apertures, which surround
+     * the vehicle, is only bounded by the longest range
+     */
+    TxCone calcTxCone() override;
+
+    /**
+     * @brief Initializes a DeciderVlcApertures with one DeciderVlc per aperture
+     */
+    std::unique_ptr<Decider> initializeDeciderVlc(ParameterMap& params) override;
+
+    void setTransmissionEnd(simtime_t end) override;
+};
+
+} // namespace veins
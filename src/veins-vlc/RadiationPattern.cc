@@ -19,6 +19,9 @@
 //
 
 #include "veins-vlc/RadiationPattern.h"
+
+#include <algorithm>
+
 /**
    RadiationPattern::RadiationPattern(std::string m_id, std::vector<double> m_patternLeft, std::vector<double> m_patternRight, std::vector<double> m_anglesLeft, std::vector<double> m_anglesRight, std::vector<double> m_spectralEmission) {
     id = m_id;
@@ -55,3 +58,11 @@ double RadiationPattern::getAnglesRightFromIndex(int index)
 {
     return anglesRight[index];
 }
+
+double RadiationPattern::getPatternPeak()
+{
+    double peak = 0;
+    if (!patternLeft.empty()) peak = std::max(peak, *std::max_element(patternLeft.begin(), patternLeft.end()));
+    if (!patternRight.empty()) peak = std::max(peak, *std::max_element(patternRight.begin(), patternRight.end()));
+    return peak;
+}
@@ -41,6 +41,12 @@ public:
     double getAnglesLeftFromIndex(int index);
     double getAnglesRightFromIndex(int index);
 
+    /**
+     * @brief Returns the largest value of the left and right pattern,
+     * i.e., the irradiance in the brightest direction
+     */
+    double getPatternPeak();
+
 private:
     std::string id;
     std::vector<double> patternLeft;
@@ -67,8 +67,10 @@ void Splitter::initialize()
     mobility = dynamic_cast<TraCIMobility*>(tmpMobility);
     ASSERT(mobility);
 
+    // Vehicles which are not equipped with VLC have no VLC NICs at all
     vlcPhys = getSubmodulesOfType<PhyLayerVlc>(getParentModule(), true);
-    ASSERT(vlcPhys.size() > 0);
+    isVlcEquipped = vlcPhys.size() > 0;
+    hasUnifiedVlcNic = vlcPhys.size() == 1 && vlcPhys[0]->getNumApertures() > 1;
 
     annotationManager = AnnotationManagerAccess().getIfExists();
     ASSERT(annotationManager);
@@ -121,19 +123,26 @@ void Splitter::handleUpperMessage(cMessage* msg)
         EV_INFO << "DSRC message received from upper layer!" << std::endl;
         send(vlcMsg, toDsrcNic);
     }
+    else if (networkType == VLC && !isVlcEquipped) {
+        EV_INFO << "VLC message received from upper layer, but not equipped with VLC: dropping it" << std::endl;
+        vlcPacketsDropped++;
+        delete vlcMsg;
+    }
     else if (networkType == VLC) {
         EV_INFO << "VLC message received from upper layer!" << std::endl;
         if (draw) {
             // Won't draw at simTime() < 0.1 as TraCI is not connected and annotation fails
             auto drawCones = [this]() {
+                const AntennaPosition head = hasUnifiedVlcNic ? vlcPhys[0]->getAperturePoa(APERTURE_HEAD).pos : vlcPhys[0]->getAntennaPosition();
+                const AntennaPosition tail = hasUnifiedVlcNic ? vlcPhys[0]->getAperturePoa(APERTURE_TAIL).pos : vlcPhys[1]->getAntennaPosition();
                 // Headlight, right
-                drawRayLine(vlcPhys[0]->getAntennaPosition(), 100, headHalfAngle);
+                drawRayLine(head, 100, headHalfAngle);
                 // left
-                drawRayLine(vlcPhys[0]->getAntennaPosition(), 100, -headHalfAngle);
+                drawRayLine(head, 100, -headHalfAngle);
                 // Taillight, left
-                drawRayLine(vlcPhys[1]->getAntennaPosition(), 30, tailHalfAngle, true);
+                drawRayLine(tail, 30, tailHalfAngle, true);
                 // right
-                drawRayLine(vlcPhys[1]->getAntennaPosition(), 30, -tailHalfAngle, true);
+                drawRayLine(tail, 30, -tailHalfAngle, true);
             };
             // The cones will be drawn immediately as a message is received from the layer above
             timerManager.create(veins::TimerSpecification(drawCones).oneshotAt(simTime()));
@@ -141,6 +150,16 @@ void Splitter::handleUpperMessage(cMessage* msg)
 
         int lightModule = vlcMsg->getTransmissionModule();
 
+        if (hasUnifiedVlcNic) {
+            // The MAC selects the apertures from the light module of the message
+            if (lightModule == HEADLIGHT) headlightPacketsSent++;
+            else if (lightModule == TAILLIGHT) taillightPacketsSent++;
+            else if (lightModule == BOTH_LIGHTS) vlcPacketsSent++;
+            else error("\tThe light module has not been specified in the message!");
+            send(vlcMsg, toVlcHead);
+            return;
+        }
+
         switch (lightModule) {
         case HEADLIGHT:
             headlightPacketsSent++;
@@ -159,11 +178,9 @@ void Splitter::handleUpperMessage(cMessage* msg)
             toHead->setTransmissionModule(HEADLIGHT);
             send(toHead, toVlcHead);
 
-            VlcMessage* toTail = vlcMsg->dup();
-            toTail->setTransmissionModule(TAILLIGHT);
-            send(toTail, toVlcTail);
-            delete vlcMsg;
-            vlcMsg = NULL;
+            // the tail gets the original message, saving a copy
+            vlcMsg->setTransmissionModule(TAILLIGHT);
+            send(vlcMsg, toVlcTail);
             break;
         }
         default:
@@ -195,12 +212,15 @@ void Splitter::handleLowerMessage(cMessage* msg)
             taillightPacketsReceived++;
             emit(tailVlcDelaySignal, simTime() - vlcMsg->getTimestamp());
         }
-        else
+        // sent by both light modules of a unified NIC at once
+        else if (srclightModule != BOTH_LIGHTS)
             error("neither `head` nor `tail`");
 
     }
 
-    if (VlcMessage* vlcMsg = dynamic_cast<VlcMessage*>(msg)) {
+    // A unified NIC receives on either photodiode, so the message keeps the light module it was sent with
+    VlcMessage* vlcMsg = dynamic_cast<VlcMessage*>(msg);
+    if (vlcMsg && !hasUnifiedVlcNic) {
         if (lowerGate == fromVlcHead) vlcMsg->setTransmissionModule(HEADLIGHT);
         if (lowerGate == fromVlcTail) vlcMsg->setTransmissionModule(TAILLIGHT);
     }
@@ -229,4 +249,5 @@ void Splitter::finish()
     recordScalar("taillightPacketsReceived", taillightPacketsReceived);
     recordScalar("vlcPacketsSent", vlcPacketsSent);
     recordScalar("vlcPacketsReceived", vlcPacketsReceived);
+    if (!isVlcEquipped) recordScalar("vlcPacketsDropped", vlcPacketsDropped);
 }
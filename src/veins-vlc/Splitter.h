@@ -54,6 +54,9 @@ protected:
     bool debug;
     bool collectStatistics;
     bool draw;
+    bool isVlcEquipped;
+    /** @brief Whether a single NIC (PhyLayerVlcVehicle) serves both light modules, attached to the headlight gates */
+    bool hasUnifiedVlcNic;
     double headHalfAngle;
     double tailHalfAngle;
     TraCIMobility* mobility;
@@ -68,6 +71,7 @@ protected:
     int headlightPacketsReceived = 0;
     int taillightPacketsReceived = 0;
     int vlcPacketsReceived = 0;
+    int vlcPacketsDropped = 0;
 
     // Signals
     simsignal_t totalVlcDelaySignal;
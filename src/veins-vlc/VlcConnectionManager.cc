@@ -20,17 +20,309 @@
 
 #include "veins-vlc/VlcConnectionManager.h"
 
+#include <algorithm>
 #include <cmath>
+#include <set>
 
 #include "veins/base/modules/BaseWorldUtility.h"
+#include "veins-vlc/PhyLayerVlc.h"
 
 Define_Module(veins::VlcConnectionManager);
 
 using namespace veins;
 
+// Turn of a light module (in rad) which invalidates the predictions of its links
+static const double MAX_DIRECTION_CHANGE = 1e-3;
+
+void VlcConnectionManager::initialize(int stage)
+{
+    BaseConnectionManager::initialize(stage);
+    if (stage == 0) {
+        coneCulling = par("coneCulling").boolValue();
+        useConeGrid = par("useConeGrid").boolValue();
+        coneGridCellSize = par("coneGridCellSize").doubleValue();
+        coneGrid.setCellSize(coneGridCellSize > 0 ? coneGridCellSize : maxInterferenceDistance);
+        predictLinkLifetime = par("predictLinkLifetime").boolValue();
+        maxLinkLifetime = par("maxLinkLifetime").doubleValue();
+        velocityTolerance = par("velocityTolerance").doubleValue();
+    }
+}
+
+void VlcConnectionManager::finish()
+{
+    if (predictLinkLifetime) {
+        recordScalar("linkEvaluations", linkEvaluations);
+        recordScalar("linkEvaluationsSkipped", linkEvaluationsSkipped);
+    }
+
+    BaseConnectionManager::finish();
+}
+
+bool VlcConnectionManager::unregisterNic(cModule* nic)
+{
+    int nicId = nic->getId();
+    coneGrid.remove(nicId);
+    txDirections.erase(nicId);
+    hostIds.erase(nicId);
+    return BaseConnectionManager::unregisterNic(nic);
+}
+
+void VlcConnectionManager::checkOpticalBands(const std::vector<OpticalBand>& bands)
+{
+    if (!opticalBandsChecked) {
+        opticalBands = bands;
+        opticalBandsChecked = true;
+    }
+    else if (bands != opticalBands) {
+        throw cRuntimeError("opticalBands need to be the same for all NICs");
+    }
+}
+
 double VlcConnectionManager::calcInterfDist()
 {
     // The interference distance is hard-coded based on our empirical VLC model,
     // there communication is not possible above 350 m, so this presents an upper-bound
     return 380;
 }
+
+void VlcConnectionManager::updateNicConnections(NicEntries& nmap, NicEntry* nic)
+{
+    if (!coneCulling) {
+        // as BaseConnectionManager does, but NICs of the same host are never connected in the first place
+        for (auto& entry : nmap) {
+            NicEntry* other = entry.second;
+            if (other->nicId == nic->nicId) continue;
+
+            bool inRange = !isSameHost(nic, other) && isInRange(nic, other);
+            bool connected = nic->isConnected(other);
+            if (inRange && !connected) {
+                nic->connectTo(other);
+                other->connectTo(nic);
+            }
+            else if (!inRange && connected) {
+                nic->disconnectFrom(other);
+                other->disconnectFrom(nic);
+            }
+        }
+        return;
+    }
+    if (useConeGrid) {
+        updateIndexedNicConnections(nic);
+        return;
+    }
+
+    for (auto& entry : nmap) {
+        NicEntry* other = entry.second;
+
+        // no recursive connections
+        if (other->nicId == nic->nicId) continue;
+
+        // links are directed, so check both of them
+        updateLink(nic, other);
+        updateLink(other, nic);
+    }
+}
+
+void VlcConnectionManager::updateIndexedNicConnections(NicEntry* nic)
+{
+    int id = nic->nicId;
+    PhyLayerVlc* phy = dynamic_cast<PhyLayerVlc*>(nic->chAccess);
+    Coord txDirection = phy ? phy->getTxDirection() : Coord();
+
+    // BaseConnectionManager calls updateNicConnections once per cell of its own grid around the NIC
+    bool known = coneGrid.contains(id);
+    if (known && coneGrid.getPosition(id) == nic->pos && txDirections[id] == txDirection) return;
+
+    Coord oldPos = known ? coneGrid.getPosition(id) : nic->pos;
+    coneGrid.update(id, nic->pos);
+    txDirections[id] = txDirection;
+
+    // Links from the NIC: the ones currently connected and all NICs inside its cone
+    std::set<int> receivers;
+    for (auto& gate : nic->getGateList()) {
+        receivers.insert(gate.first->nicId);
+    }
+    if (phy) {
+        for (int otherId : coneGrid.queryCone(nic->pos, txDirection, getClassTxCone(phy))) receivers.insert(otherId);
+    }
+    else {
+        hasUnboundedNics = true;
+        for (int otherId : coneGrid.queryRange(nic->pos, maxInterferenceDistance)) receivers.insert(otherId);
+    }
+    for (int otherId : receivers) {
+        if (otherId == id) continue;
+        if (NicEntry* other = findIndexedNic(otherId)) updateLink(nic, other);
+    }
+
+    // Links to the NIC: every NIC which might illuminate its new position or has illuminated its old one
+    for (int otherId : coneGrid.queryRange(nic->pos, getMaxRange() + oldPos.distance(nic->pos))) {
+        if (otherId == id) continue;
+        if (NicEntry* other = findIndexedNic(otherId)) updateLink(other, nic);
+    }
+}
+
+NicEntry* VlcConnectionManager::findIndexedNic(int nicId)
+{
+    auto it = nics.find(nicId);
+    if (it == nics.end()) {
+        // NIC has been unregistered since it was last indexed
+        coneGrid.remove(nicId);
+        txDirections.erase(nicId);
+        hostIds.erase(nicId);
+        return nullptr;
+    }
+    return it->second;
+}
+
+double VlcConnectionManager::getMaxRange() const
+{
+    if (hasUnboundedNics || rangeClasses.empty()) return maxInterferenceDistance;
+
+    double maxRange = 0;
+    for (auto& rangeClass : rangeClasses) {
+        maxRange = std::max(maxRange, rangeClass.second);
+    }
+    return std::min(maxRange, maxInterferenceDistance);
+}
+
+void VlcConnectionManager::updateLink(NicEntry* tx, NicEntry* rx)
+{
+    if (isSameHost(tx, rx)) {
+        if (tx->isConnected(rx)) tx->disconnectFrom(rx);
+        return;
+    }
+
+    PhyLayerVlc* txPhy = dynamic_cast<PhyLayerVlc*>(tx->chAccess);
+    PhyLayerVlc* rxPhy = dynamic_cast<PhyLayerVlc*>(rx->chAccess);
+    bool predict = predictLinkLifetime && txPhy && rxPhy;
+
+    int64_t linkKey = (static_cast<int64_t>(tx->nicId) << 32) | static_cast<uint32_t>(rx->nicId);
+    if (predict) {
+        auto it = linkPredictions.find(linkKey);
+        if (it != linkPredictions.end() && isPredictionValid(it->second, txPhy, rxPhy)) {
+            ++linkEvaluationsSkipped;
+            return;
+        }
+    }
+    ++linkEvaluations;
+
+    bool inCone = isInRange(tx, rx) && isInCone(tx, rx);
+    bool connected = tx->isConnected(rx);
+
+    if (inCone && !connected) {
+        EV_TRACE << "nic #" << tx->nicId << " illuminates nic #" << rx->nicId << endl;
+        tx->connectTo(rx);
+    }
+    else if (!inCone && connected) {
+        EV_TRACE << "nic #" << tx->nicId << " no longer illuminates nic #" << rx->nicId << endl;
+        tx->disconnectFrom(rx);
+    }
+
+    if (predict) {
+        linkPredictions[linkKey] = predictLink(tx, rx, txPhy, rxPhy);
+
+        // Predictions of NICs which have left the simulation are never looked up again
+        if (linkPredictions.size() > 2 * linkPredictionsPurgedSize + 1024) {
+            for (auto it = linkPredictions.begin(); it != linkPredictions.end();) {
+                if (it->second.validUntil <= simTime()) {
+                    it = linkPredictions.erase(it);
+                }
+                else {
+                    ++it;
+                }
+            }
+            linkPredictionsPurgedSize = linkPredictions.size();
+        }
+    }
+}
+
+bool VlcConnectionManager::isSameHost(NicEntry* a, NicEntry* b)
+{
+    auto getHostId = [this](NicEntry* nic) {
+        auto it = hostIds.find(nic->nicId);
+        if (it != hostIds.end()) return it->second;
+        int hostId = nic->chAccess->findHost()->getId();
+        hostIds[nic->nicId] = hostId;
+        return hostId;
+    };
+    return getHostId(a) == getHostId(b);
+}
+
+bool VlcConnectionManager::isPredictionValid(const LinkPrediction& prediction, PhyLayerVlc* txPhy, PhyLayerVlc* rxPhy) const
+{
+    if (simTime() >= prediction.validUntil) return false;
+
+    // Lane changes, braking, turning: the movement the prediction assumed no longer holds
+    if ((rxPhy->getVelocity() - txPhy->getVelocity() - prediction.relativeVelocity).length() > velocityTolerance) return false;
+    if (txPhy->getTxDirection() * prediction.txDirection < cos(MAX_DIRECTION_CHANGE)) return false;
+
+    return true;
+}
+
+VlcConnectionManager::LinkPrediction VlcConnectionManager::predictLink(NicEntry* tx, NicEntry* rx, PhyLayerVlc* txPhy, PhyLayerVlc* rxPhy)
+{
+    LinkPrediction prediction;
+    prediction.txDirection = txPhy->getTxDirection();
+    prediction.relativeVelocity = rxPhy->getVelocity() - txPhy->getVelocity();
+
+    // The cone moves along with the transmitter, so only the relative movement of the receiver
+    // matters. The tolerance covers the drift the prediction still accepts as unchanged
+    double boundaryDistance = getClassTxCone(txPhy).getBoundaryDistance(tx->pos, prediction.txDirection, rx->pos);
+    double maxRelativeSpeed = prediction.relativeVelocity.atZ(0).length() + velocityTolerance;
+
+    simtime_t lifetime = maxLinkLifetime;
+    if (maxRelativeSpeed > 0 && boundaryDistance / maxRelativeSpeed < lifetime.dbl()) {
+        lifetime = boundaryDistance / maxRelativeSpeed;
+    }
+    prediction.validUntil = simTime() + lifetime;
+
+    EV_TRACE << "link from nic #" << tx->nicId << " to nic #" << rx->nicId << " is " << boundaryDistance << " m from changing, re-evaluating in " << lifetime << " s" << endl;
+    return prediction;
+}
+
+bool VlcConnectionManager::isInCone(NicEntry* tx, NicEntry* rx)
+{
+    PhyLayerVlc* txPhy = dynamic_cast<PhyLayerVlc*>(tx->chAccess);
+    // not a VLC NIC, fall back to the interference distance
+    if (!txPhy) return true;
+
+    return getClassTxCone(txPhy).contains(tx->pos, txPhy->getTxDirection(), rx->pos);
+}
+
+TxCone VlcConnectionManager::getClassTxCone(PhyLayerVlc* txPhy)
+{
+    TxCone cone = txPhy->getTxCone();
+    cone.range = std::min(getRangeClass(txPhy), maxInterferenceDistance);
+    return cone;
+}
+
+double VlcConnectionManager::getRangeClass(PhyLayerVlc* txPhy)
+{
+    double range = txPhy->getTxCone().range;
+    auto result = rangeClasses.emplace(txPhy->getLightingModuleOrientation(), range);
+    double& classRange = result.first->second;
+
+    if (range > classRange) {
+        classRange = range;
+    }
+    else if (!result.second) {
+        return classRange;
+    }
+
+    // Cells sized to the shortest range class keep the candidates of its cone queries few
+    if (coneGridCellSize <= 0) {
+        double shortestRange = maxInterferenceDistance;
+        for (auto& rangeClass : rangeClasses) {
+            shortestRange = std::min(shortestRange, rangeClass.second);
+        }
+        if (shortestRange > 0) coneGrid.setCellSize(shortestRange);
+    }
+
+    if (classRange > maxInterferenceDistance) {
+        EV_WARN << "range of " << txPhy->getFullPath() << " is " << classRange << " m, but only NICs within the interference distance of " << maxInterferenceDistance << " m can be connected" << endl;
+    }
+    else {
+        EV_DEBUG << "range class of " << txPhy->getFullPath() << " is " << classRange << " m" << endl;
+    }
+    return classRange;
+}
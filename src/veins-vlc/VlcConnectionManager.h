@@ -20,12 +20,21 @@
 
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 #include "veins-vlc/veins-vlc.h"
 
 #include "veins/base/connectionManager/BaseConnectionManager.h"
+#include "veins-vlc/utility/ConeGrid.h"
+#include "veins-vlc/utility/OpticalBand.h"
 
 namespace veins {
 
+class PhyLayerVlc;
+
 /**
  * @brief BaseConnectionManager implementation which only defines a
  * specific max interference distance.
@@ -34,13 +43,176 @@ namespace veins {
  * power, wavelength, pathloss coefficient and a threshold for the
  * minimal receive Power.
  *
+ * Unlike radio links, VLC links are directed: a light module only
+ * reaches receivers inside the cone it is facing. If coneCulling is
+ * enabled, a NIC is only connected to the NICs within its TxCone, so
+ * no AirFrame copies are created for receivers the light models would
+ * attenuate to zero anyway.
+ *
+ * The range of the cone is derived from the analogue models of each
+ * NIC. NICs are grouped into range classes by the orientation of their
+ * light module, so headlights and taillights are culled separately.
+ * The interference distance only bounds the largest range class.
+ *
+ * If useConeGrid is enabled, NICs are additionally kept in a ConeGrid
+ * with cells sized to the shortest range class. On every move of a NIC
+ * only the NICs inside its cone and those within the largest range of
+ * it are considered, instead of all NICs of the surrounding cells of
+ * the (much coarser) grid of the BaseConnectionManager.
+ *
+ * If predictLinkLifetime is enabled, the distance of the receiver to the
+ * boundary of the cone and the relative velocity of both NICs give a
+ * time before which the link cannot change. Until then (but at most for
+ * maxLinkLifetime) the link is not re-evaluated, unless either NIC
+ * changes its velocity or the light module turns.
+ *
+ * NICs of the same host (e.g., headlight and taillight of a car) are
+ * never connected, as a host does not receive its own frames.
+ *
  * @ingroup connectionManager
  */
 class VEINS_VLC_API VlcConnectionManager : public BaseConnectionManager {
+public:
+    void initialize(int stage) override;
+    void finish() override;
+
+    /**
+     * @brief Drops the NIC from coneGrid and the other per-NIC state
+     * before unregistering it
+     */
+    bool unregisterNic(cModule* nic) override;
+
+    /**
+     * @brief Throws a cRuntimeError unless opticalBands are the bands
+     * of all NICs checked before
+     */
+    void checkOpticalBands(const std::vector<OpticalBand>& opticalBands);
+
 protected:
+    /** @brief Predicted lifetime of the state of a directed link */
+    struct LinkPrediction {
+        /** @brief Time until which the link cannot change its state */
+        simtime_t validUntil;
+        /** @brief Velocity of the receiver relative to the transmitter the prediction assumes */
+        Coord relativeVelocity;
+        /** @brief Direction of the transmitting light module the prediction assumes */
+        Coord txDirection;
+    };
+
+    /** @brief Whether to only connect NICs within the cone of the transmitter */
+    bool coneCulling;
+
+    /** @brief Whether to find the NICs to connect via coneGrid */
+    bool useConeGrid;
+
+    /** @brief Configured size of the cells of coneGrid; if not positive, the shortest range class is used */
+    double coneGridCellSize;
+
+    /** @brief Spatial index of all NICs, by nicId */
+    ConeGrid coneGrid;
+
+    /** @brief Direction of the light module of each NIC when it was last indexed */
+    std::map<int, Coord> txDirections;
+
+    /** @brief Whether any NIC without a TxCone has been indexed, which is only bounded by the interference distance */
+    bool hasUnboundedNics = false;
+
+    /** @brief Largest range of all NICs seen so far, per orientation of their light module */
+    std::map<int, double> rangeClasses;
+
+    /** @brief Whether to skip re-evaluating links until their predicted change */
+    bool predictLinkLifetime;
+
+    /** @brief Upper bound of any predicted lifetime, i.e., the fallback refresh interval */
+    simtime_t maxLinkLifetime;
+
+    /** @brief Change in relative velocity (m/s) which invalidates a prediction */
+    double velocityTolerance;
+
+    /** @brief Predictions by tx nicId and rx nicId */
+    std::unordered_map<int64_t, LinkPrediction> linkPredictions;
+
+    /** @brief Size of linkPredictions after expired predictions were last dropped */
+    size_t linkPredictionsPurgedSize = 0;
+
+    /** @brief Id of the host module of each NIC, by nicId */
+    std::unordered_map<int, int> hostIds;
+
+    long linkEvaluations = 0;
+    long linkEvaluationsSkipped = 0;
+
+    /** @brief Bands of the first NIC checked by checkOpticalBands */
+    std::vector<OpticalBand> opticalBands;
+    bool opticalBandsChecked = false;
+
+    /**
+     * @brief Updates the connections of nic to and from all NICs in nmap,
+     * taking the direction of the light modules into account.
+     */
+    void updateNicConnections(NicEntries& nmap, NicEntry* nic) override;
+
+    /**
+     * @brief Updates the connections of nic to and from all other NICs,
+     * finding the candidates via coneGrid
+     */
+    void updateIndexedNicConnections(NicEntry* nic);
+
+    /**
+     * @brief Returns the registered NIC with the given id, or nullptr
+     * (dropping it from coneGrid) if it is no longer registered
+     */
+    NicEntry* findIndexedNic(int nicId);
+
+    /**
+     * @brief Returns the largest distance at which any NIC can be connected
+     */
+    double getMaxRange() const;
+
+    /**
+     * @brief Connects or disconnects the directed link from tx to rx,
+     * unless its prediction is still valid
+     */
+    void updateLink(NicEntry* tx, NicEntry* rx);
+
+    /**
+     * @brief Returns whether both NICs belong to the same host
+     */
+    bool isSameHost(NicEntry* a, NicEntry* b);
+
+    /**
+     * @brief Returns whether prediction still holds for the current
+     * movement of txPhy and rxPhy
+     */
+    bool isPredictionValid(const LinkPrediction& prediction, PhyLayerVlc* txPhy, PhyLayerVlc* rxPhy) const;
+
+    /**
+     * @brief Predicts until when the link from tx to rx keeps its state,
+     * assuming both NICs keep their velocity
+     */
+    LinkPrediction predictLink(NicEntry* tx, NicEntry* rx, PhyLayerVlc* txPhy, PhyLayerVlc* rxPhy);
+
+    /**
+     * @brief Returns whether the light module of tx illuminates rx
+     */
+    virtual bool isInCone(NicEntry* tx, NicEntry* rx);
+
+    /**
+     * @brief Returns the cone of txPhy, with the range of its range class
+     */
+    TxCone getClassTxCone(PhyLayerVlc* txPhy);
+
+    /**
+     * @brief Returns the range of the range class of txPhy, adding the
+     * range of txPhy to it
+     */
+    double getRangeClass(PhyLayerVlc* txPhy);
+
     /**
      * @brief Calculate interference distance
      *
+     * Upper bound of the range of all NICs, which determines the size of
+     * the grid cells of the connection manager.
+     *
      * Calculation of the interference distance based on the transmitter
      * power, wavelength, pathloss coefficient and a threshold for the
      * minimal receive Power
@@ -0,0 +1,50 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/VlcPoolStatistics.h"
+
+#include "veins-vlc/DeciderResultVlc.h"
+#include "veins-vlc/mac/MacPktVlc.h"
+#include "veins-vlc/messages/AirFrameVlc_m.h"
+
+Define_Module(veins::VlcPoolStatistics);
+
+using namespace veins;
+
+void VlcPoolStatistics::initialize()
+{
+    ObjectPool<AirFrameVlc>::resetStatistics();
+    ObjectPool<MacPktVlc>::resetStatistics();
+    ObjectPool<DeciderResultVlc>::resetStatistics();
+}
+
+void VlcPoolStatistics::finish()
+{
+    recordPoolStatistics("airFramePool", ObjectPool<AirFrameVlc>::getStatistics());
+    recordPoolStatistics("macPktPool", ObjectPool<MacPktVlc>::getStatistics());
+    recordPoolStatistics("deciderResultPool", ObjectPool<DeciderResultVlc>::getStatistics());
+}
+
+void VlcPoolStatistics::recordPoolStatistics(const std::string& name, const ObjectPoolStatistics& statistics)
+{
+    recordScalar((name + "Allocations").c_str(), statistics.allocations);
+    recordScalar((name + "HighWater").c_str(), statistics.highWater);
+    recordScalar((name + "ReuseRatio").c_str(), statistics.getReuseRatio());
+}
@@ -0,0 +1,51 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins-vlc/utility/ObjectPool.h"
+
+namespace veins {
+
+/**
+ * @brief Records the statistics of the ObjectPools of the VLC NICs.
+ *
+ * The pools of AirFrameVlc, MacPktVlc and DeciderResultVlc are static,
+ * i.e., shared by all NICs and all runs of the process. This module
+ * resets their statistics at the start of a run and records them as
+ * scalars at its end.
+ */
+class VEINS_VLC_API VlcPoolStatistics : public cSimpleModule {
+public:
+    void initialize() override;
+    void finish() override;
+
+protected:
+    /**
+     * @brief Records the statistics of an ObjectPool as scalars prefixed with name
+     */
+    void recordPoolStatistics(const std::string& name, const ObjectPoolStatistics& statistics);
+};
+
+} // namespace veins
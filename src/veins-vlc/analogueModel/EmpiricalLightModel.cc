@@ -20,6 +20,9 @@
 
 #include "veins-vlc/analogueModel/EmpiricalLightModel.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "veins/base/messages/AirFrame_m.h"
 #include "veins-vlc/messages/AirFrameVlc_m.h"
 #include "veins-vlc/analogueModel/FittedEmpiricalLightModel.h"
@@ -2009,10 +2012,38 @@ static const double ccTailModel[30][41] = {{-116.99, -116.99, -116.99, -116.99,
      -111.93, -112.08, -112.22, -112.36, -112.49, -116.99, -116.99,
      -116.99, -116.99, -116.99, -116.99, -116.99}};
 
+// Parameters of the FittedEmpiricalLightModel, obtained by curve fitting the headlight measurements
+static const double FITTED_ALPHA = 695.3;
+static const double FITTED_BETA = 4.949;
+static const double FITTED_GAMMA = 1;
+static const double FITTED_PERIOD = 173;
+static const double FITTED_DELTA = -747.3;
+static const double FITTED_EPSILON = 63.13;
+
+// Largest distance at which a cell of the model above threshold_dbm can be queried.
+// Queries truncate the relative (x,y) of the receiver, so a cell covers up to one meter more in each direction
+template <size_t ROWS, size_t COLS>
+static double getModelRange(const double (&model)[ROWS][COLS], int maxXSpan, double threshold_dbm)
+{
+    double range = 0;
+    for (size_t row = 0; row < ROWS; ++row) {
+        for (size_t col = 0; col < COLS; ++col) {
+            if (model[row][col] <= threshold_dbm) continue;
+            double relativeXaxis = std::abs(int(col) - maxXSpan) + 1;
+            double relativeYaxis = row + 2; // row = relativeYaxis - 1
+            range = std::max(range, sqrt(relativeXaxis * relativeXaxis + relativeYaxis * relativeYaxis));
+        }
+    }
+    return range;
+}
+
 void EmpiricalLightModel::filterSignal(Signal* signal)
 {
-    auto sender = signal->getSenderPoa();
-    auto receiver = signal->getReceiverPoa();
+    *signal *= getAttenuation(*signal, signal->getSenderPoa(), signal->getReceiverPoa());
+}
+
+double EmpiricalLightModel::getAttenuation(const Signal& signal, const POA& sender, const POA& receiver)
+{
 
     const Coord senderPos2D = sender.pos.getPositionAt().atZ(0);
     const Coord receiverPos2D = receiver.pos.getPositionAt().atZ(0);
@@ -2167,7 +2198,7 @@ void EmpiricalLightModel::filterSignal(Signal* signal)
     double powerFinal = FIXED_REFERENCE_POWER_MW * attenuationFactor;
     EV_TRACE << "Power [mw & db] after multiplying with the attenuationFactor: [" << powerFinal << " mW & " << FWMath::mW2dBm(powerFinal) << " dbm]" << std::endl;
 
-    *signal *= attenuationFactor;
+    return attenuationFactor;
 }
 
 double EmpiricalLightModel::calcReceivedPower(int txOrientation, double tx2RxDistance, const Coord& tx2RxVector, const Coord& txHeadingVector, const Coord& rxHeadingVector)
@@ -2246,7 +2277,7 @@ double EmpiricalLightModel::calcFittedReceivedPower(double tx2RxDistance, const
 
     double tmpRecvPower = sensitivity_dbm;
 
-    tmpRecvPower = getTotalPower_dbm(tx2RxDistance, angle_transformed, 695.3, 4.949, 1, 173, -747.3, 63.13); // parameters from curve fitting
+    tmpRecvPower = getTotalPower_dbm(tx2RxDistance, angle_transformed, FITTED_ALPHA, FITTED_BETA, FITTED_GAMMA, FITTED_PERIOD, FITTED_DELTA, FITTED_EPSILON);
     EV_TRACE << "Fitted Power: " << tmpRecvPower << std::endl;
     return tmpRecvPower;
 }
@@ -2261,3 +2292,58 @@ int EmpiricalLightModel::getLightingModuleOrientation(POA poa)
     }
     throw cRuntimeError("EmpiricalLightModel only handles transmissions by AntennaHeadlight or AntennaTaillight");
 }
+
+TxCone EmpiricalLightModel::getTxCone(int txOrientation) const
+{
+    TxCone cone;
+    switch (txOrientation) {
+    case HEAD:
+        cone.halfAngle = headlightMaxTxAngle;
+        cone.range = calcModelRange(txOrientation);
+        // Beyond the measurements the fitted model takes over, which only falls below the sensitivity eventually
+        cone.range = std::max(cone.range, calcFittedRange());
+        break;
+    case TAIL:
+        cone.halfAngle = taillightMaxTxAngle;
+        cone.range = calcModelRange(txOrientation);
+        break;
+    default:
+        throw cRuntimeError("Unknown sender heading. Neither `HEAD` nor `TAIL`!");
+        break;
+    }
+    return cone;
+}
+
+double EmpiricalLightModel::calcModelRange(int txOrientation) const
+{
+    // calcReceivedPower scales the queried power by cosIncidenceAngle / cosIrradianceAngle,
+    // which is largest at the border of the field-of-view
+    switch (txOrientation) {
+    case HEAD: {
+        double threshold_dbm = sensitivity_dbm + 10 * log10(cos(headlightMaxTxAngle));
+        return std::min(headlightMaxTxRange, getModelRange(ccHeadModel, HEAD_MAX_X_SPAN, threshold_dbm));
+    }
+    case TAIL: {
+        double threshold_dbm = sensitivity_dbm + 10 * log10(cos(taillightMaxTxAngle));
+        return std::min(taillightMaxTxRange, getModelRange(ccTailModel, TAIL_MAX_X_SPAN, threshold_dbm));
+    }
+    default: {
+        throw cRuntimeError("Unknown sender heading. Neither `HEAD` nor `TAIL`!");
+        break;
+    }
+    }
+}
+
+double EmpiricalLightModel::calcFittedRange() const
+{
+    // Strongest angular component of the fitted model within the field-of-view (same transformation as in calcFittedReceivedPower)
+    double maxPowerAngle_dbm = -std::numeric_limits<double>::infinity();
+    double maxAngle_deg = rad2deg(headlightMaxTxAngle);
+    for (double irradianceAngle_deg = -maxAngle_deg; irradianceAngle_deg <= maxAngle_deg; irradianceAngle_deg += 0.1) {
+        double angle_transformed = fabs(irradianceAngle_deg - 90) + 90;
+        maxPowerAngle_dbm = std::max(maxPowerAngle_dbm, getPowerAngle_dbm(angle_transformed, FITTED_PERIOD, FITTED_DELTA, FITTED_EPSILON));
+    }
+
+    // The distance-dependent part decreases monotonically, so this is where the total power reaches the sensitivity
+    return getDistanceAtPower(sensitivity_dbm - maxPowerAngle_dbm, FITTED_ALPHA, FITTED_BETA, FITTED_GAMMA);
+}
@@ -31,7 +31,9 @@
 #include "veins/modules/mobility/traci/TraCIMobility.h"
 #include "veins/modules/world/annotations/AnnotationManager.h"
 #include "veins-vlc/utility/Utils.h"
+#include "veins-vlc/utility/TxCone.h"
 #include "veins/base/utils/POA.h"
+#include "veins-vlc/analogueModel/SingleCarrierAnalogueModel.h"
 
 using veins::AirFrame;
 using veins::AnnotationManager;
@@ -53,7 +55,7 @@ namespace veins {
  * The values are recorded as observed from the spectrum analyzer
  * to which the PD is connected -- this is electrical power
  */
-class VEINS_VLC_API EmpiricalLightModel : public AnalogueModel {
+class VEINS_VLC_API EmpiricalLightModel : public AnalogueModel, public SingleCarrierAnalogueModel {
 protected:
     AnnotationManager* annotations;
 
@@ -83,8 +85,32 @@ public:
 
     void filterSignal(Signal*) override;
 
+    double getAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa) override;
+
     int getLightingModuleOrientation(POA poa);
 
+    /**
+     * @brief Returns the region outside of which this model attenuates
+     * transmissions of a light module with the given orientation to zero.
+     *
+     * The range is the extent of the measurements which are above the
+     * sensitivity and, for the headlight, the distance at which the
+     * fitted model drops below the sensitivity.
+     */
+    TxCone getTxCone(int txOrientation) const;
+
+    /**
+     * @brief Returns the largest distance at which the measurements of the
+     * given light module yield a received power above the sensitivity.
+     */
+    double calcModelRange(int txOrientation) const;
+
+    /**
+     * @brief Returns the distance at which the fitted model drops below the
+     * sensitivity in all directions of the headlight field-of-view.
+     */
+    double calcFittedRange() const;
+
     bool isRecvPowerUnderSensitivity(int senderHeading, double distanceFromSenderToReceiver, const Coord& vectorFromTx2Rx, const Coord& vectorTxHeading, const Coord& vectorRxHeading);
     double calcReceivedPower(int senderHeading, double distanceFromSenderToReceiver, const Coord& vectorFromTx2Rx, const Coord& vectorTxHeading, const Coord& vectorRxHeading);
     double calcFittedReceivedPower(double distanceFromSenderToReceiver, const Coord& vectorFromTx2Rx, const Coord& vectorTxHeading);
@@ -29,6 +29,11 @@ double getPowerDistance_dbm(double distance, double alpha, double beta, double g
     return alpha + 10 * beta * log10(1 / (distance + gamma));
 }
 
+double getDistanceAtPower(double power_dbm, double alpha, double beta, double gamma)
+{
+    return pow(10, (alpha - power_dbm) / (10 * beta)) - gamma;
+}
+
 double getPowerAngle_dbm(double angle, double period, double delta, double epsilon)
 {
     return delta + epsilon * cos(2 * M_PI * angle / period);
@@ -42,6 +42,12 @@ namespace veins {
 
 double getPowerDistance_dbm(double distance, double alpha, double beta, double gamma);
 
+/**
+ * @brief Inverse of getPowerDistance_dbm: returns the distance at which the
+ * distance-dependent part of the model yields the given power
+ */
+double getDistanceAtPower(double power_dbm, double alpha, double beta, double gamma);
+
 double getPowerAngle_dbm(double angle, double period, double delta, double epsilon);
 
 double getTotalPower_dbm(double distance, double angle, double alpha, double beta, double gamma, double period, double delta, double epsilon);
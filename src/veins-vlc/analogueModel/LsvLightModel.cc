@@ -18,6 +18,7 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
+#include <algorithm>
 #include <limits>
 
 #include <veins-vlc/analogueModel/LsvLightModel.h>
@@ -145,9 +146,32 @@ Photodiode* LsvLightModel::getPhotodiodeFromKey(std::string key)
 
 void LsvLightModel::filterSignal(Signal* signal)
 {
-    auto sender = signal->getSenderPoa();
-    auto receiver = signal->getReceiverPoa();
+    double attenuationFactor = calcAttenuation(signal->getSenderPoa(), signal->getReceiverPoa());
+    if (opticalBands.empty()) {
+        *signal *= attenuationFactor;
+        return;
+    }
+    for (size_t i = 0; i < opticalBands.size(); ++i) {
+        signal->at(i) *= attenuationFactor * getBandWeight(i);
+    }
+}
 
+double LsvLightModel::getAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa)
+{
+    double attenuationFactor = calcAttenuation(senderPoa, receiverPoa);
+    if (opticalBands.empty()) return attenuationFactor;
+    return attenuationFactor * getBandWeight(signal.getCenterFrequencyIndex());
+}
+
+double LsvLightModel::getBandWeight(size_t band)
+{
+    // The electrical power grows with the square of the photo-current
+    double responsivityRatio = getBandResponsivityRatio(RP->getSpectralEmission(), PD->getSpectralResponse(), opticalBands[band]);
+    return responsivityRatio * responsivityRatio;
+}
+
+double LsvLightModel::calcAttenuation(const POA& sender, const POA& receiver)
+{
     auto senderPos = sender.pos.getPositionAt();
 
     auto* senderAntenna = dynamic_cast<AntennaVlc*>(sender.antenna.get());
@@ -297,8 +321,7 @@ void LsvLightModel::filterSignal(Signal* signal)
     if (recvPower_dbm > sensitivity_dbm) {
         attenuationFactor = recvPowermW / FIXED_REFERENCE_POWER_MW;
     }
-
-    *signal *= attenuationFactor;
+    return attenuationFactor;
 }
 
 int LsvLightModel::getLightingModuleOrientation(POA poa)
@@ -311,3 +334,48 @@ int LsvLightModel::getLightingModuleOrientation(POA poa)
     }
     throw cRuntimeError("EmpiricalLightModel only handles transmissions by AntennaHeadlight or AntennaTaillight");
 }
+
+TxCone LsvLightModel::getTxCone(const AntennaVlc& txAntenna)
+{
+    RadiationPattern* pattern = getRadiationPatternFromKey(txAntenna.radiationPatternId);
+
+    // Largest horizontal angle covered by either the left or the right light module
+    double maxPhi_deg = std::max({std::fabs(pattern->getAnglesLeftFromIndex(0)), std::fabs(pattern->getAnglesLeftFromIndex(1)), std::fabs(pattern->getAnglesRightFromIndex(0)), std::fabs(pattern->getAnglesRightFromIndex(1))});
+
+    TxCone cone;
+    cone.range = calcRange(txAntenna);
+    if (maxPhi_deg > 90 || maxPhi_deg <= 0) {
+        // Pattern reaches behind the light modules (or is degenerate); not bounded by a cone
+        return cone;
+    }
+    cone.halfAngle = deg2rad(maxPhi_deg);
+
+    // Both light modules are interModuleDistance / 2 to the side of the antenna position.
+    // Moving the apex back covers the cones of both of them.
+    if (maxPhi_deg < 90) {
+        cone.apexOffset = (txAntenna.interModuleDistance / 2) / tan(cone.halfAngle);
+    }
+    return cone;
+}
+
+double LsvLightModel::calcRange(const AntennaVlc& txAntenna)
+{
+    RP = getRadiationPatternFromKey(txAntenna.radiationPatternId);
+
+    // The most sensitive photodiode any receiver might use
+    double maxResponse = 0;
+    for (auto& entry : *PD_Map) {
+        PD = &entry.second;
+        maxResponse = std::max(maxResponse, PD->getArea() * PD->getGain() * getCurrentFactor());
+    }
+    if (maxResponse <= 0) return std::numeric_limits<double>::infinity();
+
+    // Upper bound of the power received from both light modules at distance d, with both cosines at 1:
+    //   2 * (peak / d * maxResponse)^2 / 50 * 1000 mW
+    // Solving for the distance at which this equals the sensitivity
+    double sensitivity_mW = FWMath::dBm2mW(sensitivity_dbm);
+    double distance = RP->getPatternPeak() * maxResponse * sqrt(2 * 1000 / 50 / sensitivity_mW);
+
+    // The light modules are offset from the antenna position
+    return distance + txAntenna.interModuleDistance / 2;
+}
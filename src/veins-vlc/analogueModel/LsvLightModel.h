@@ -29,8 +29,12 @@
 #include "veins/modules/mobility/traci/TraCIMobility.h"
 #include "veins/modules/world/annotations/AnnotationManager.h"
 #include "veins-vlc/utility/Utils.h"
+#include "veins-vlc/utility/TxCone.h"
+#include "veins-vlc/utility/OpticalBand.h"
+#include "veins-vlc/analogueModel/SingleCarrierAnalogueModel.h"
 
 #include "veins-vlc/PhyLayerVlc.h"
+#include "veins-vlc/AntennaVlc.h"
 #include "veins-vlc/Photodiode.h"
 #include "veins-vlc/RadiationPattern.h"
 
@@ -51,17 +55,24 @@ namespace veins {
  * to which the PD is connected -- this is electrical power
  */
 
-class VEINS_VLC_API LsvLightModel : public AnalogueModel {
+class VEINS_VLC_API LsvLightModel : public AnalogueModel, public SingleCarrierAnalogueModel {
 protected:
     AnnotationManager* annotations;
 
     bool debug = true;
     double sensitivity_dbm;
+    std::vector<OpticalBand> opticalBands;
 
 public:
-    LsvLightModel(cComponent* owner, std::map<std::string, RadiationPattern>* RadiationPattern_Map, std::map<std::string, Photodiode>* Photodiode_Map, double sensitivity)
+    /**
+     * opticalBands holds the band of each frequency of the spectrum, if any.
+     * The received power on each of them is weighted by the responsivity of
+     * the photodiode to the emission of the light module within the band.
+     */
+    LsvLightModel(cComponent* owner, std::map<std::string, RadiationPattern>* RadiationPattern_Map, std::map<std::string, Photodiode>* Photodiode_Map, double sensitivity, std::vector<OpticalBand> opticalBands = {})
         : AnalogueModel(owner)
         , sensitivity_dbm(sensitivity)
+        , opticalBands(opticalBands)
         , RP_Map(RadiationPattern_Map)
         , PD_Map(Photodiode_Map)
     {
@@ -71,6 +82,8 @@ public:
 
     virtual void filterSignal(Signal* signal) override;
 
+    double getAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa) override;
+
     virtual bool neverIncreasesPower() override
     {
         return true;
@@ -86,6 +99,32 @@ public:
     int getLightingModuleOrientation(POA poa);
     double getCurrentFactor();
 
+    /**
+     * @brief Returns the factor the light module and photodiode of the
+     * last link attenuate the given band by, relative to white light
+     */
+    double getBandWeight(size_t band);
+
+    /**
+     * @brief Returns the attenuation from sender to receiver, without
+     * the weights of the optical bands
+     */
+    double calcAttenuation(const POA& sender, const POA& receiver);
+
+    /**
+     * @brief Returns the region outside of which this model attenuates
+     * transmissions of the given light module to zero, i.e., the
+     * horizontal field-of-view of its radiation pattern.
+     */
+    TxCone getTxCone(const AntennaVlc& txAntenna);
+
+    /**
+     * @brief Returns the distance beyond which no photodiode receives
+     * transmissions of the given light module above the sensitivity,
+     * based on the peak of its radiation pattern.
+     */
+    double calcRange(const AntennaVlc& txAntenna);
+
     std::map<std::string, RadiationPattern>* RP_Map;
     std::map<std::string, Photodiode>* PD_Map;
     RadiationPattern* RP;
@@ -0,0 +1,53 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins/base/toolbox/Signal.h"
+
+namespace veins {
+
+/**
+ * @brief Analogue model which attenuates the power of a frame by a
+ * factor depending only on the sender, the receiver, and the carrier.
+ *
+ * VLC frames are sent on a single carrier and are constant over their
+ * duration, so their received power is a scalar. PhyLayerVlc computes
+ * it via getAttenuation instead of filtering a copy of the Signal for
+ * every receiver, as long as all of its analogue models implement
+ * this interface.
+ *
+ * @ingroup analogueModels
+ */
+class VEINS_VLC_API SingleCarrierAnalogueModel {
+public:
+    virtual ~SingleCarrierAnalogueModel() = default;
+
+    /**
+     * @brief Returns the factor filterSignal would scale the power of
+     * signal on its center frequency by, if sent from senderPoa to
+     * receiverPoa. The POAs of signal itself are ignored.
+     */
+    virtual double getAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa) = 0;
+};
+
+} // namespace veins
@@ -20,19 +20,218 @@
 
 #include "veins-vlc/analogueModel/VehicleObstacleShadowingForVlc.h"
 
+#include <utility>
+
+#include "veins/base/utils/FindModule.h"
+#include "veins/modules/mobility/traci/TraCIMobility.h"
+#include "veins/modules/mobility/traci/TraCIScenarioManager.h"
+
 using namespace veins;
 
-VehicleObstacleShadowingForVlc::VehicleObstacleShadowingForVlc(cComponent* owner, VehicleObstacleControl& vehicleObstacleControl, bool useTorus, const Coord& playgroundSize)
+std::weak_ptr<VehicleObstacleShadowingForVlc::SharedState> VehicleObstacleShadowingForVlc::sharedState;
+
+VehicleObstacleShadowingForVlc::VehicleObstacleShadowingForVlc(cComponent* owner, VehicleObstacleControl& vehicleObstacleControl, bool useTorus, const Coord& playgroundSize, bool useLaneIndex, bool useLosCache, bool useVehicleBoxes)
     : VehicleObstacleShadowing(owner, vehicleObstacleControl, useTorus, playgroundSize)
+    , useLaneIndex(useLaneIndex)
+    , useLosCache(useLosCache)
+    , useVehicleBoxes(useVehicleBoxes)
 {
     if (useTorus) throw cRuntimeError("VehicleObstacleShadowing does not work on torus-shaped playgrounds");
+
+    if (useLaneIndex || useLosCache || useVehicleBoxes) {
+        state = sharedState.lock();
+        if (!state) {
+            state = std::make_shared<SharedState>();
+            sharedState = state;
+        }
+    }
 }
 
 void VehicleObstacleShadowingForVlc::filterSignal(Signal* signal)
 {
-    auto potentialObstacles = vehicleObstacleControl.getPotentialObstacles(signal->getSenderPoa().pos, signal->getReceiverPoa().pos, *signal);
+    if (getAttenuation(*signal, signal->getSenderPoa(), signal->getReceiverPoa()) == 0) *signal *= 0;
+}
+
+double VehicleObstacleShadowingForVlc::getAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa)
+{
+    if (!state) {
+        return isBlocked(senderPoa.pos, receiverPoa.pos, signal) ? 0 : 1;
+    }
+
+    int senderHostId = state->getHostId(senderPoa.pos.getId());
+    int receiverHostId = state->getHostId(receiverPoa.pos.getId());
+    bool isVehiclePair = senderHostId != receiverHostId && senderHostId >= 0 && receiverHostId >= 0;
+
+    if (!useLosCache || !isVehiclePair) {
+        return isBlocked(senderPoa.pos, receiverPoa.pos, signal, senderHostId, receiverHostId) ? 0 : 1;
+    }
+
+    bool blocked;
+    if (state->lookupLineOfSight(senderHostId, receiverHostId, blocked)) {
+        ++losCacheHits;
+    }
+    else {
+        ++losCacheMisses;
+        blocked = isBlocked(senderPoa.pos, receiverPoa.pos, signal, senderHostId, receiverHostId);
+        state->storeLineOfSight(senderHostId, receiverHostId, blocked);
+    }
+    return blocked ? 0 : 1;
+}
+
+bool VehicleObstacleShadowingForVlc::isBlocked(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const Signal& signal, int senderHostId, int receiverHostId)
+{
+    if (useLaneIndex && senderHostId != receiverHostId) {
+        const LaneIndex* index = state->getLaneIndex(senderHostId, receiverHostId);
+
+        // On the same lane, only the vehicles in between can block the line of sight
+        if (index && index->isSameLane(senderHostId, receiverHostId)) {
+            return index->countInBetween(senderHostId, receiverHostId) > 0;
+        }
+    }
+
+    if (useVehicleBoxes) {
+        simtime_t now = simTime();
+        return state->getVehicleBoxes().isBlocked(senderPos.getPositionAt(now), receiverPos.getPositionAt(now), senderHostId, receiverHostId);
+    }
 
-    if (potentialObstacles.size() < 1) return;
+    auto potentialObstacles = vehicleObstacleControl.getPotentialObstacles(senderPos, receiverPos, signal);
+    return potentialObstacles.size() > 0;
+}
+
+VehicleObstacleShadowingForVlc::SharedState::SharedState()
+{
+    cModule* systemModule = getSimulation()->getSystemModule();
+    systemModule->subscribe(TraCIScenarioManager::traciTimestepEndSignal, this);
+    systemModule->subscribe(TraCIScenarioManager::traciModuleRemovedSignal, this);
+}
+
+VehicleObstacleShadowingForVlc::SharedState::~SharedState()
+{
+    cModule* systemModule = getSimulation()->getSystemModule();
+    if (systemModule) {
+        systemModule->unsubscribe(TraCIScenarioManager::traciTimestepEndSignal, this);
+        systemModule->unsubscribe(TraCIScenarioManager::traciModuleRemovedSignal, this);
+    }
+}
+
+void VehicleObstacleShadowingForVlc::SharedState::receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details)
+{
+    // Vehicles only move while TraCI processes a time step; signalled once all of them have moved,
+    // this invalidates everything derived from their positions without rebuilding in between
+    if (signalID == TraCIScenarioManager::traciTimestepEndSignal) ++mobilityEpoch;
+}
+
+void VehicleObstacleShadowingForVlc::SharedState::receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details)
+{
+    if (signalID != TraCIScenarioManager::traciModuleRemovedSignal) return;
+
+    int hostId = check_and_cast<cModule*>(obj)->getId();
+    vehicleSizes.erase(hostId);
+    for (auto it = hostIds.begin(); it != hostIds.end();) {
+        if (it->second == hostId) {
+            it = hostIds.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
 
-    *signal *= 0;
+int VehicleObstacleShadowingForVlc::SharedState::getHostId(int nicId)
+{
+    auto it = hostIds.find(nicId);
+    if (it != hostIds.end()) return it->second;
+
+    cModule* host = FindModule<>::findHost(getSimulation()->getModule(nicId));
+    int hostId = host ? host->getId() : -1;
+    hostIds[nicId] = hostId;
+    return hostId;
+}
+
+const LaneIndex* VehicleObstacleShadowingForVlc::SharedState::getLaneIndex(int hostIdA, int hostIdB)
+{
+    if (laneIndexEpoch != mobilityEpoch) {
+        laneIndex.clear();
+        indexedRoads.clear();
+        roadIds.clear();
+        for (auto& managedHost : TraCIScenarioManagerAccess().get()->getManagedHosts()) {
+            cModule* host = managedHost.second;
+            TraCIMobility* mobility = FindModule<TraCIMobility*>::findSubModule(host);
+            if (mobility) roadIds[host->getId()] = mobility->getRoadId();
+        }
+        laneIndexEpoch = mobilityEpoch;
+    }
+
+    // vehicles on different roads cannot be on the same lane; this needs no query to TraCI
+    auto roadA = roadIds.find(hostIdA);
+    auto roadB = roadIds.find(hostIdB);
+    if (roadA == roadIds.end() || roadB == roadIds.end() || roadA->second != roadB->second) return nullptr;
+
+    if (indexedRoads.insert(roadA->second).second) indexRoad(roadA->second);
+    return &laneIndex;
+}
+
+void VehicleObstacleShadowingForVlc::SharedState::indexRoad(const std::string& roadId)
+{
+    // lanes are not part of the variables TraCIMobility subscribes to, so they are only queried for the roads that are needed
+    for (auto& managedHost : TraCIScenarioManagerAccess().get()->getManagedHosts()) {
+        cModule* host = managedHost.second;
+        auto road = roadIds.find(host->getId());
+        if (road == roadIds.end() || road->second != roadId) continue;
+
+        auto vehicle = FindModule<TraCIMobility*>::findSubModule(host)->getVehicleCommandInterface();
+        laneIndex.add(host->getId(), vehicle->getLaneId(), vehicle->getLanePosition());
+    }
+    laneIndex.build();
+}
+
+const VehicleBoxes& VehicleObstacleShadowingForVlc::SharedState::getVehicleBoxes()
+{
+    if (vehicleBoxesEpoch != mobilityEpoch) rebuildVehicleBoxes();
+    return vehicleBoxes;
+}
+
+void VehicleObstacleShadowingForVlc::SharedState::rebuildVehicleBoxes()
+{
+    vehicleBoxes.clear();
+    simtime_t now = simTime();
+    for (auto& managedHost : TraCIScenarioManagerAccess().get()->getManagedHosts()) {
+        cModule* host = managedHost.second;
+        TraCIMobility* mobility = FindModule<TraCIMobility*>::findSubModule(host);
+        if (!mobility) continue;
+
+        auto size = vehicleSizes.find(host->getId());
+        if (size == vehicleSizes.end()) {
+            auto vehicle = mobility->getVehicleCommandInterface();
+            size = vehicleSizes.insert({host->getId(), {vehicle->getLength(), vehicle->getWidth()}}).first;
+        }
+        vehicleBoxes.add(host->getId(), mobility->getPositionAt(now), mobility->getHeading().toCoord(), size->second.first, size->second.second);
+    }
+    vehicleBoxesEpoch = mobilityEpoch;
+}
+
+uint64_t VehicleObstacleShadowingForVlc::SharedState::getPairKey(int hostIdA, int hostIdB)
+{
+    // line of sight is symmetric, so is the key
+    if (hostIdA > hostIdB) std::swap(hostIdA, hostIdB);
+    return (static_cast<uint64_t>(static_cast<uint32_t>(hostIdA)) << 32) | static_cast<uint32_t>(hostIdB);
+}
+
+bool VehicleObstacleShadowingForVlc::SharedState::lookupLineOfSight(int hostIdA, int hostIdB, bool& blocked)
+{
+    if (losCacheEpoch != mobilityEpoch) {
+        losCache.clear();
+        losCacheEpoch = mobilityEpoch;
+        return false;
+    }
+
+    auto it = losCache.find(getPairKey(hostIdA, hostIdB));
+    if (it == losCache.end()) return false;
+    blocked = it->second;
+    return true;
+}
+
+void VehicleObstacleShadowingForVlc::SharedState::storeLineOfSight(int hostIdA, int hostIdB, bool blocked)
+{
+    losCache[getPairKey(hostIdA, hostIdB)] = blocked;
 }
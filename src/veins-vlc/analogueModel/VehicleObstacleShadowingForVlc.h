@@ -26,8 +26,16 @@
 #include "veins/modules/obstacle/VehicleObstacleControl.h"
 #include "veins/base/utils/Move.h"
 #include "veins/base/messages/AirFrame_m.h"
+#include "veins-vlc/utility/LaneIndex.h"
+#include "veins-vlc/utility/VehicleBoxes.h"
+#include "veins-vlc/analogueModel/SingleCarrierAnalogueModel.h"
 
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace veins {
 
@@ -35,9 +43,22 @@ namespace veins {
  * @brief Basic implementation of a VehicleObstacleShadowingForVlc
  * which subclasses VehicleObstacleShadowing
  *
+ * Optionally, links between two vehicles on the same lane are decided
+ * by a LaneIndex shared among all instances: such a link is blocked iff
+ * another vehicle is in between on this lane. Vehicles on other lanes
+ * are then not considered as obstacles. Only links between vehicles on
+ * different lanes (or not managed by TraCI) are checked geometrically.
+ *
+ * Also optionally, the line of sight between two vehicles is cached
+ * until vehicles move and shared by all NICs of both vehicles, i.e.,
+ * it is only computed for one of their pairs of light modules.
+ *
+ * Finally, the geometric test can be run against VehicleBoxes of all
+ * vehicles, which tests many vehicles at once using SIMD instructions.
+ *
  * @ingroup analogueModels
  */
-class VehicleObstacleShadowingForVlc : public VehicleObstacleShadowing {
+class VehicleObstacleShadowingForVlc : public VehicleObstacleShadowing, public SingleCarrierAnalogueModel {
 
 public:
     /**
@@ -50,8 +71,11 @@ public:
      * @param vehicleObstacleControl reference to global VehicleObstacleControl module
      * @param useTorus information about the playground the host is moving in
      * @param playgroundSize information about the playground the host is moving in
+     * @param useLaneIndex whether to decide same-lane links by the order of vehicles on the lane
+     * @param useLosCache whether to share the line of sight between two vehicles among all their NICs until vehicles move
+     * @param useVehicleBoxes whether to test the line of sight against VehicleBoxes instead of VehicleObstacleControl
      */
-    VehicleObstacleShadowingForVlc(cComponent* owner, VehicleObstacleControl& vehicleObstacleControl, bool useTorus, const Coord& playgroundSize);
+    VehicleObstacleShadowingForVlc(cComponent* owner, VehicleObstacleControl& vehicleObstacleControl, bool useTorus, const Coord& playgroundSize, bool useLaneIndex = false, bool useLosCache = false, bool useVehicleBoxes = false);
 
     /**
      * @brief Filters a specified Signal by adding an attenuation
@@ -59,10 +83,105 @@ public:
      */
     virtual void filterSignal(Signal* signal) override;
 
+    /**
+     * @brief Returns 0 if the line of sight from senderPoa to
+     * receiverPoa is blocked, 1 otherwise
+     */
+    double getAttenuation(const Signal& signal, const POA& senderPoa, const POA& receiverPoa) override;
+
     virtual bool neverIncreasesPower() override
     {
         return true;
     }
+
+    long getLosCacheHits() const
+    {
+        return losCacheHits;
+    }
+
+    long getLosCacheMisses() const
+    {
+        return losCacheMisses;
+    }
+
+protected:
+    /**
+     * @brief State derived from the positions of all vehicles, shared by
+     * all instances and invalidated whenever vehicles move
+     */
+    class SharedState : public cListener {
+    public:
+        SharedState();
+        ~SharedState() override;
+
+        void receiveSignal(cComponent* source, simsignal_t signalID, const SimTime& t, cObject* details) override;
+        void receiveSignal(cComponent* source, simsignal_t signalID, cObject* obj, cObject* details) override;
+
+        /**
+         * @brief Returns the id of the host of the NIC with the given id
+         */
+        int getHostId(int nicId);
+
+        /**
+         * @brief Returns a LaneIndex holding both vehicles if they are on
+         * the same road, nullptr otherwise
+         */
+        const LaneIndex* getLaneIndex(int hostIdA, int hostIdB);
+
+        /**
+         * @brief Returns the VehicleBoxes of all vehicles managed by TraCI,
+         * rebuilding them first if vehicles have moved
+         */
+        const VehicleBoxes& getVehicleBoxes();
+
+        /**
+         * @brief Returns whether the line of sight between two vehicles is
+         * known for their current positions; if so, sets blocked
+         */
+        bool lookupLineOfSight(int hostIdA, int hostIdB, bool& blocked);
+
+        void storeLineOfSight(int hostIdA, int hostIdB, bool blocked);
+
+    protected:
+        long mobilityEpoch = 0;
+        std::unordered_map<int, int> hostIds;
+
+        /** @brief Lanes of the vehicles on the roads in indexedRoads */
+        LaneIndex laneIndex;
+        long laneIndexEpoch = -1;
+        std::unordered_set<std::string> indexedRoads;
+        /** @brief Road of each vehicle, as already known by its TraCIMobility */
+        std::unordered_map<int, std::string> roadIds;
+
+        VehicleBoxes vehicleBoxes;
+        long vehicleBoxesEpoch = -1;
+        /** @brief Length and width of the vehicle of each host; they are queried only once */
+        std::unordered_map<int, std::pair<double, double>> vehicleSizes;
+
+        /** @brief Whether the line of sight is blocked, by unordered pair of hosts */
+        std::unordered_map<uint64_t, bool> losCache;
+        long losCacheEpoch = -1;
+
+        void indexRoad(const std::string& roadId);
+        void rebuildVehicleBoxes();
+        static uint64_t getPairKey(int hostIdA, int hostIdB);
+    };
+
+    bool useLaneIndex;
+    bool useLosCache;
+    bool useVehicleBoxes;
+    long losCacheHits = 0;
+    long losCacheMisses = 0;
+
+    /** @brief The state of this simulation, if useLaneIndex, useLosCache or useVehicleBoxes is set */
+    std::shared_ptr<SharedState> state;
+
+    static std::weak_ptr<SharedState> sharedState;
+
+    /**
+     * @brief Returns whether an obstacle blocks the line of sight between both positions
+     */
+    bool isBlocked(const AntennaPosition& senderPos, const AntennaPosition& receiverPos, const Signal& signal, int senderHostId = -1, int receiverHostId = -1);
 };
 
 } // namespace veins
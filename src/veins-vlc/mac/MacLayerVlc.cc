@@ -23,6 +23,16 @@
 #include "veins/base/phyLayer/MacToPhyInterface.h"
 #include "veins/base/messages/MacPkt_m.h"
 #include "veins-vlc/PhyLayerVlc.h"
+#include "veins-vlc/mac/MacPktVlc.h"
+#include "veins-vlc/utility/ConstsVlc.h"
+#include "veins-vlc/utility/PhyModesVlc.h"
+#include "veins-vlc/utility/Utils.h"
+#include "veins/base/phyLayer/PhyToMacControlInfo.h"
+#include "veins/modules/phy/DeciderResult80211.h"
+#include "veins-vlc/messages/VlcMessage_m.h"
+
+#include <algorithm>
+#include <limits>
 
 using namespace veins;
 
@@ -43,7 +53,41 @@ void MacLayerVlc::initialize(int stage)
 
         queueSize = par("queueSize");
         transmitting = false;
+
+        phyMode = par("phyMode");
+        rateAdaptation = par("rateAdaptation").boolValue();
+        phyType = par("phyType");
+        targetPdr = par("targetPdr").doubleValue();
+        sinrHistory = par("sinrHistory").doubleValue();
+        if (phyMode != -1) getVlcPhyMode(phyMode);
+
+        fragmentation = par("fragmentation").boolValue();
+        if (fragmentation && headerLength + MAC_VLC_FRAGMENT_HEADER >= PHY_VLC_PSDU) error("headerLength leaves no room for fragments in a PSDU");
+        // fragmented messages of other NICs are reassembled regardless of fragmentation
+        reassemblyBuffer.reset(new ReassemblyBuffer(par("reassemblySlots").intValue(), par("reassemblyTimeout").doubleValue()));
+    }
+}
+
+MacLayerVlc::~MacLayerVlc()
+{
+    for (auto fragment : fragments) {
+        delete fragment;
+    }
+}
+
+void MacLayerVlc::finish()
+{
+    if (fragmentation) {
+        recordScalar("fragmentedMessagesSent", fragmentedMessagesSent);
+        recordScalar("fragmentsSent", fragmentsSent);
+    }
+    if (fragmentation || fragmentsReceived > 0) {
+        recordScalar("fragmentsReceived", fragmentsReceived);
+        recordScalar("fragmentsMissing", reassemblyBuffer->getFragmentsMissing());
+        recordScalar("messagesReassembled", reassemblyBuffer->getReassembled());
+        recordScalar("messagesDiscarded", reassemblyBuffer->getDiscarded());
     }
+    BaseMacLayer::finish();
 }
 
 void MacLayerVlc::handleUpperMsg(cMessage* msg)
@@ -56,9 +100,64 @@ void MacLayerVlc::handleUpperMsg(cMessage* msg)
     }
     else {
         if (!queue.isEmpty()) throw cRuntimeError("Radio not transmitting but packets in queue");
-        sendDown(encapsMsg(check_and_cast<cPacket*>(msg)));
-        transmitting = true;
+        sendPacket(check_and_cast<cPacket*>(msg));
+    }
+}
+
+void MacLayerVlc::handleLowerMsg(cMessage* msg)
+{
+    if (rateAdaptation) {
+        PhyToMacControlInfo* controlInfo = check_and_cast<PhyToMacControlInfo*>(msg->getControlInfo());
+        DeciderResult80211* result = check_and_cast<DeciderResult80211*>(controlInfo->getDeciderResult());
+        recentSinrs.push_back({simTime(), result->getSnr()});
+    }
+
+    MacPktVlc* pkt = check_and_cast<MacPktVlc*>(msg);
+    if (pkt->getFragmentCount() > 1) {
+        ++fragmentsReceived;
+        bool first = pkt->getFragmentNumber() == 0;
+        cPacket* complete = reassemblyBuffer->add(pkt->getSrcAddr(), pkt->getSequenceNumber(), pkt->getFragmentNumber(), pkt->getFragmentCount(), first ? pkt : nullptr, simTime());
+        if (!first) delete pkt;
+        if (!complete) return;
+
+        // the first fragment becomes the whole message again
+        pkt = check_and_cast<MacPktVlc*>(complete);
+        pkt->setBitLength(headerLength + MAC_VLC_FRAGMENT_HEADER + pkt->getEncapsulatedPacket()->getBitLength());
+        EV_TRACE << "Reassembled message " << pkt->getSequenceNumber() << " from " << pkt->getFragmentCount() << " fragments\n";
     }
+    BaseMacLayer::handleLowerMsg(pkt);
+}
+
+int MacLayerVlc::selectPhyMode(int bitLength)
+{
+    if (!rateAdaptation) return phyMode;
+
+    while (!recentSinrs.empty() && recentSinrs.front().first < simTime() - sinrHistory) {
+        recentSinrs.pop_front();
+    }
+
+    double minSinr = std::numeric_limits<double>::infinity();
+    for (auto& recentSinr : recentSinrs) minSinr = std::min(minSinr, recentSinr.second);
+
+    double referenceBitrate = check_and_cast<PhyLayerVlc*>(phy)->getBitrate();
+    const auto& modes = getVlcPhyModes();
+    int fastest = -1;
+    int mostRobust = -1;
+    for (int id = 0; id < static_cast<int>(modes.size()); ++id) {
+        const VlcPhyMode& mode = modes[id];
+        if (mode.phyType != phyType) continue;
+        if (mostRobust == -1 || mode.getDataRate() < modes[mostRobust].getDataRate()) mostRobust = id;
+        if (recentSinrs.empty()) continue;
+        if (fastest != -1 && mode.getDataRate() <= modes[fastest].getDataRate()) continue;
+
+        double snr = getVlcPhyModeSnr(mode, minSinr, referenceBitrate);
+        if (getVlcPhyModePdr(mode, snr, bitLength + PHY_VLC_HEADER) >= targetPdr) fastest = id;
+    }
+    if (mostRobust == -1) throw cRuntimeError("No VLC PHY mode of PHY type %d", phyType);
+
+    int selected = (fastest != -1) ? fastest : mostRobust;
+    EV_TRACE << "Selected PHY mode " << selected << " at " << modes[selected].getDataRate() << " bit/s\n";
+    return selected;
 }
 
 void MacLayerVlc::handleLowerControl(cMessage* msg)
@@ -78,8 +177,15 @@ void MacLayerVlc::handleLowerControl(cMessage* msg)
 
 MacPkt* MacLayerVlc::encapsMsg(cPacket* netwPkt)
 {
-    MacPkt* pkt = new MacPkt(netwPkt->getName(), netwPkt->getKind());
+    MacPktVlc* pkt = new MacPktVlc(netwPkt->getName(), netwPkt->getKind());
     pkt->addBitLength(headerLength);
+    pkt->setPhyMode(selectPhyMode(pkt->getBitLength() + netwPkt->getBitLength()));
+
+    // The light module chosen by the application selects the apertures of a PHY with several of them
+    if (auto vlcMsg = dynamic_cast<VlcMessage*>(netwPkt)) {
+        if (vlcMsg->getTransmissionModule() == HEADLIGHT) pkt->setTxApertures(1 << APERTURE_HEAD);
+        if (vlcMsg->getTransmissionModule() == TAILLIGHT) pkt->setTxApertures(1 << APERTURE_TAIL);
+    }
 
     // TODO: setting up proper control info: according to the interfaces (?)
 
@@ -108,11 +214,62 @@ void MacLayerVlc::enqueuePacket(cPacket* pkt)
 
 void MacLayerVlc::transmissionOpportunity()
 {
+    if (!fragments.empty()) {
+        sendDown(fragments.front());
+        fragments.pop_front();
+        transmitting = true;
+        return;
+    }
+
     if (queue.isEmpty()) {
         return;
     }
 
-    sendDown(encapsMsg(queue.pop()));
+    sendPacket(queue.pop());
     // emit(sigQueueLength, queue.getLength());
+}
+
+void MacLayerVlc::sendPacket(cPacket* netwPkt)
+{
+    MacPktVlc* pkt = check_and_cast<MacPktVlc*>(encapsMsg(netwPkt));
+    if (fragmentation) {
+        fragment(pkt);
+        pkt = fragments.front();
+        fragments.pop_front();
+    }
+    sendDown(pkt);
     transmitting = true;
 }
+
+void MacLayerVlc::fragment(MacPktVlc* pkt)
+{
+    int64_t fragmentHeaderLength = headerLength + MAC_VLC_FRAGMENT_HEADER;
+    int64_t payloadLength = pkt->getBitLength() - headerLength;
+    int64_t maxFragmentPayloadLength = PHY_VLC_PSDU - fragmentHeaderLength;
+    int fragmentCount = std::max<int64_t>(1, (payloadLength + maxFragmentPayloadLength - 1) / maxFragmentPayloadLength);
+    if (fragmentCount > MAC_VLC_MAX_FRAGMENTS) {
+        throw cRuntimeError("Packet of %d bits needs more than %d fragments", static_cast<int>(payloadLength), MAC_VLC_MAX_FRAGMENTS);
+    }
+
+    int sequenceNumber = nextSequenceNumber++;
+    for (int i = 0; i < fragmentCount; ++i) {
+        MacPktVlc* fragment = pkt;
+        if (i > 0) {
+            fragment = new MacPktVlc(pkt->getName(), pkt->getKind());
+            fragment->setDestAddr(pkt->getDestAddr());
+            fragment->setSrcAddr(pkt->getSrcAddr());
+        }
+        // the first fragment carries the message, but only accounts for its share of the bits
+        int64_t fragmentPayloadLength = std::min(maxFragmentPayloadLength, payloadLength - i * maxFragmentPayloadLength);
+        fragment->setBitLength(fragmentHeaderLength + fragmentPayloadLength);
+        fragment->setSequenceNumber(sequenceNumber);
+        fragment->setFragmentNumber(i);
+        fragment->setFragmentCount(fragmentCount);
+        fragment->setPhyMode(selectPhyMode(fragment->getBitLength()));
+        fragment->setTxApertures(pkt->getTxApertures());
+        fragments.push_back(fragment);
+    }
+
+    if (fragmentCount > 1) ++fragmentedMessagesSent;
+    fragmentsSent += fragmentCount;
+}
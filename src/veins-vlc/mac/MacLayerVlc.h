@@ -22,27 +22,87 @@
 
 #include "veins/veins.h"
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+
 #include "veins/base/modules/BaseMacLayer.h"
+#include "veins-vlc/mac/MacPktVlc.h"
+#include "veins-vlc/mac/ReassemblyBuffer.h"
 
 namespace veins {
 
 class MacLayerVlc : public BaseMacLayer {
 public:
+    ~MacLayerVlc() override;
+
     void initialize(int) override;
+    void finish() override;
 
     void handleUpperMsg(cMessage* msg) override;
+    void handleLowerMsg(cMessage* msg) override;
     void handleLowerControl(cMessage* msg) override;
     MacPkt* encapsMsg(cPacket* netwPkt) override;
 
     void enqueuePacket(cPacket* pkt);
     void transmissionOpportunity();
 
+    /**
+     * @brief Encapsulates netwPkt and sends it, or its first fragment
+     * if it does not fit into a PSDU and fragmentation is enabled
+     */
+    void sendPacket(cPacket* netwPkt);
+
+    /**
+     * @brief Splits pkt into fragments whose PSDU is at most PHY_VLC_PSDU
+     * long and appends them to fragments
+     *
+     * The first fragment is pkt itself, which carries the message.
+     */
+    void fragment(MacPktVlc* pkt);
+
+    /**
+     * @brief Returns the operating mode to send bitLength bits with
+     *
+     * Without rateAdaptation, this is the configured phyMode. Otherwise,
+     * it is the fastest mode of phyType whose PDR meets targetPdr at the
+     * lowest SINR of the frames received within sinrHistory, or the most
+     * robust mode if there is none.
+     */
+    int selectPhyMode(int bitLength);
+
     cPacketQueue queue;
     int queueSize;
     bool transmitting;
 
 protected:
+    /** @brief Operating mode to send with, -1 for OOK at the bitrate of the PHY */
+    int phyMode;
+
+    /** @brief Whether to select the operating mode by the SINR of recently received frames */
+    bool rateAdaptation;
+    /** @brief PHY type whose operating modes rate adaptation chooses from */
+    int phyType;
+    /** @brief Minimum PDR which the selected operating mode has to meet */
+    double targetPdr;
+    /** @brief How long received SINRs are taken into account by rate adaptation */
+    simtime_t sinrHistory;
+
+    /** @brief Reception time and SINR of the frames received within sinrHistory */
+    std::deque<std::pair<simtime_t, double>> recentSinrs;
+
+    /** @brief Whether to fragment packets which exceed PHY_VLC_PSDU */
+    bool fragmentation;
+    /** @brief Fragments of the current message which have not been sent yet */
+    std::deque<MacPktVlc*> fragments;
+    /** @brief Sequence number of the next message, 8 bits as in MAC_VLC_FRAGMENT_HEADER */
+    uint8_t nextSequenceNumber = 0;
+    /** @brief Fragments received from any sender, even if this NIC does not fragment itself */
+    std::unique_ptr<ReassemblyBuffer> reassemblyBuffer;
 
+    long fragmentedMessagesSent = 0;
+    long fragmentsSent = 0;
+    long fragmentsReceived = 0;
 };
 
 } // namespace veins
@@ -0,0 +1,129 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins/base/messages/MacPkt_m.h"
+#include "veins-vlc/utility/ObjectPool.h"
+
+namespace veins {
+
+/**
+ * @brief MacPkt of MacLayerVlc, allocated from an ObjectPool
+ */
+class VEINS_VLC_API MacPktVlc : public MacPkt, public Pooled<MacPktVlc> {
+public:
+    MacPktVlc(const char* name = nullptr, short kind = 0)
+        : MacPkt(name, kind)
+    {
+    }
+
+    MacPktVlc(const MacPktVlc& other)
+        : MacPkt(other)
+        , phyMode(other.phyMode)
+        , txApertures(other.txApertures)
+        , sequenceNumber(other.sequenceNumber)
+        , fragmentNumber(other.fragmentNumber)
+        , fragmentCount(other.fragmentCount)
+    {
+    }
+
+    MacPktVlc& operator=(const MacPktVlc& other)
+    {
+        MacPkt::operator=(other);
+        phyMode = other.phyMode;
+        txApertures = other.txApertures;
+        sequenceNumber = other.sequenceNumber;
+        fragmentNumber = other.fragmentNumber;
+        fragmentCount = other.fragmentCount;
+        return *this;
+    }
+
+    MacPktVlc* dup() const override
+    {
+        return new MacPktVlc(*this);
+    }
+
+    /** @brief The operating mode the PHY is to send this packet with, -1 for its default */
+    int getPhyMode() const
+    {
+        return phyMode;
+    }
+
+    void setPhyMode(int phyMode)
+    {
+        this->phyMode = phyMode;
+    }
+
+    /** @brief Bitmask of the apertures of the PHY to send this packet with, -1 for all of them */
+    int getTxApertures() const
+    {
+        return txApertures;
+    }
+
+    void setTxApertures(int txApertures)
+    {
+        this->txApertures = txApertures;
+    }
+
+    /** @brief Number of the message of the sender this packet is (a fragment of), wrapping at 8 bits */
+    int getSequenceNumber() const
+    {
+        return sequenceNumber;
+    }
+
+    void setSequenceNumber(int sequenceNumber)
+    {
+        this->sequenceNumber = sequenceNumber;
+    }
+
+    /** @brief Index of this fragment; the first fragment carries the message */
+    int getFragmentNumber() const
+    {
+        return fragmentNumber;
+    }
+
+    void setFragmentNumber(int fragmentNumber)
+    {
+        this->fragmentNumber = fragmentNumber;
+    }
+
+    /** @brief Number of fragments of the message, 1 if it is not fragmented */
+    int getFragmentCount() const
+    {
+        return fragmentCount;
+    }
+
+    void setFragmentCount(int fragmentCount)
+    {
+        this->fragmentCount = fragmentCount;
+    }
+
+protected:
+    int phyMode = -1;
+    int txApertures = -1;
+    int sequenceNumber = 0;
+    int fragmentNumber = 0;
+    int fragmentCount = 1;
+};
+
+} // namespace veins
@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/mac/ReassemblyBuffer.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace veins;
+
+ReassemblyBuffer::~ReassemblyBuffer()
+{
+    for (auto& slot : slots) {
+        delete slot.first;
+    }
+}
+
+cPacket* ReassemblyBuffer::add(long source, long sequenceNumber, int fragmentNumber, int fragmentCount, cPacket* first, simtime_t now)
+{
+    ASSERT(fragmentNumber >= 0 && fragmentNumber < fragmentCount);
+    ASSERT((fragmentNumber == 0) == (first != nullptr));
+
+    expire(now);
+
+    auto it = std::find_if(slots.begin(), slots.end(), [source](const Slot& slot) {
+        return slot.source == source;
+    });
+    if (it != slots.end() && it->sequenceNumber != sequenceNumber) {
+        // a newer message of this source started, the old one will not be completed
+        discard(it - slots.begin());
+        it = slots.end();
+    }
+    if (it == slots.end()) {
+        if (slots.size() >= maxSlots) {
+            // make room by discarding the slot which would time out next
+            auto oldest = std::min_element(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+                return a.deadline < b.deadline;
+            });
+            discard(oldest - slots.begin());
+        }
+        slots.push_back({source, sequenceNumber, 0, std::vector<bool>(fragmentCount, false), nullptr, 0});
+        it = slots.end() - 1;
+    }
+
+    Slot& slot = *it;
+    slot.deadline = now + timeout;
+    if (slot.received[fragmentNumber]) {
+        // duplicate
+        delete first;
+        return nullptr;
+    }
+    slot.received[fragmentNumber] = true;
+    ++slot.fragmentsReceived;
+    if (first) slot.first = first;
+
+    if (slot.fragmentsReceived < fragmentCount) return nullptr;
+
+    cPacket* complete = slot.first;
+    std::swap(slot, slots.back());
+    slots.pop_back();
+    ++reassembled;
+    return complete;
+}
+
+void ReassemblyBuffer::expire(simtime_t now)
+{
+    for (size_t i = 0; i < slots.size();) {
+        if (slots[i].deadline < now) {
+            discard(i);
+        }
+        else {
+            ++i;
+        }
+    }
+}
+
+void ReassemblyBuffer::discard(size_t index)
+{
+    Slot& slot = slots[index];
+    ++discarded;
+    fragmentsMissing += slot.received.size() - slot.fragmentsReceived;
+    delete slot.first;
+    std::swap(slot, slots.back());
+    slots.pop_back();
+}
@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+/**
+ * @brief Reassembles fragmented messages of MacLayerVlc
+ *
+ * Keeps one slot per source, i.e., the fragments of an older message
+ * are discarded as soon as a fragment of a newer message of the same
+ * source arrives, as MacLayerVlc sends the fragments of a message
+ * back-to-back. At most maxSlots sources are tracked at once; a slot
+ * whose last fragment arrived more than timeout ago is discarded.
+ *
+ * Only the first fragment, which carries the message, is kept. The
+ * others are only marked as received; without the first fragment, a
+ * message is never completed.
+ */
+class VEINS_VLC_API ReassemblyBuffer {
+public:
+    ReassemblyBuffer(size_t maxSlots = 16, simtime_t timeout = 1)
+        : maxSlots(maxSlots)
+        , timeout(timeout)
+    {
+    }
+
+    ReassemblyBuffer(const ReassemblyBuffer&) = delete;
+    ReassemblyBuffer& operator=(const ReassemblyBuffer&) = delete;
+
+    ~ReassemblyBuffer();
+
+    /**
+     * @brief Adds fragment fragmentNumber of fragmentCount of a message
+     *
+     * Takes ownership of first, which is the first fragment if
+     * fragmentNumber is 0, and nullptr otherwise. Returns the first
+     * fragment once all fragments of the message were added, which is
+     * then owned by the caller, or nullptr.
+     */
+    cPacket* add(long source, long sequenceNumber, int fragmentNumber, int fragmentCount, cPacket* first, simtime_t now);
+
+    /** @brief Discards all slots which timed out at now */
+    void expire(simtime_t now);
+
+    /** @brief Number of sources with an incomplete message */
+    size_t size() const
+    {
+        return slots.size();
+    }
+
+    /** @brief Number of messages which were completed */
+    long getReassembled() const
+    {
+        return reassembled;
+    }
+
+    /** @brief Number of messages which were discarded incomplete */
+    long getDiscarded() const
+    {
+        return discarded;
+    }
+
+    /** @brief Number of fragments missing from the messages which were discarded */
+    long getFragmentsMissing() const
+    {
+        return fragmentsMissing;
+    }
+
+protected:
+    struct Slot {
+        long source;
+        long sequenceNumber;
+        int fragmentsReceived;
+        std::vector<bool> received;
+        cPacket* first;
+        simtime_t deadline;
+    };
+
+    /** @brief Counts the slot at index as discarded and removes it */
+    void discard(size_t index);
+
+    size_t maxSlots;
+    simtime_t timeout;
+    std::vector<Slot> slots;
+
+    long reassembled = 0;
+    long discarded = 0;
+    long fragmentsMissing = 0;
+};
+
+} // namespace veins
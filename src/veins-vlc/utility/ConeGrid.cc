@@ -0,0 +1,206 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/ConeGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace veins;
+
+ConeGrid::ConeGrid(double cellSize)
+    : cellSize(cellSize)
+{
+    ASSERT(cellSize > 0);
+}
+
+void ConeGrid::setCellSize(double newCellSize)
+{
+    ASSERT(newCellSize > 0);
+    if (newCellSize == cellSize) return;
+
+    cellSize = newCellSize;
+    cells.clear();
+    for (auto& entry : entries) {
+        entry.second.cell = getCellKey(entry.second.pos);
+        insertIntoCell(entry.second.cell, entry.first);
+    }
+}
+
+void ConeGrid::update(int id, const Coord& pos)
+{
+    CellKey cell = getCellKey(pos);
+
+    auto it = entries.find(id);
+    if (it == entries.end()) {
+        entries[id] = {pos, cell};
+        insertIntoCell(cell, id);
+        return;
+    }
+
+    it->second.pos = pos;
+    if (it->second.cell != cell) {
+        removeFromCell(it->second.cell, id);
+        insertIntoCell(cell, id);
+        it->second.cell = cell;
+    }
+}
+
+void ConeGrid::remove(int id)
+{
+    auto it = entries.find(id);
+    if (it == entries.end()) return;
+
+    removeFromCell(it->second.cell, id);
+    entries.erase(it);
+}
+
+bool ConeGrid::contains(int id) const
+{
+    return entries.find(id) != entries.end();
+}
+
+const Coord& ConeGrid::getPosition(int id) const
+{
+    auto it = entries.find(id);
+    ASSERT(it != entries.end());
+    return it->second.pos;
+}
+
+std::vector<int> ConeGrid::queryRange(const Coord& pos, double range) const
+{
+    std::vector<int> result;
+    const Coord pos2D = pos.atZ(0);
+    for (int id : queryBox(pos2D - Coord(range, range), pos2D + Coord(range, range))) {
+        if (entries.at(id).pos.atZ(0).distance(pos2D) <= range) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+std::vector<int> ConeGrid::queryCone(const Coord& txPos, const Coord& txDirection, const TxCone& cone) const
+{
+    const Coord txPos2D = txPos.atZ(0);
+    const Coord direction2D = txDirection.atZ(0);
+
+    // The cone is always inside the disc around the module...
+    Coord min = txPos2D - Coord(cone.range, cone.range);
+    Coord max = txPos2D + Coord(cone.range, cone.range);
+
+    // ...and, if it is narrower than a half-plane, inside the bounding box of the
+    // circular sector around its apex which reaches at least as far as the disc
+    if (cone.halfAngle < M_PI / 2 && !std::isinf(cone.range)) {
+        const Coord apex = txPos2D - direction2D * cone.apexOffset;
+        const double sectorRadius = cone.range + cone.apexOffset;
+        const double cosHalfAngle = cos(cone.halfAngle);
+        const double sinHalfAngle = sin(cone.halfAngle);
+
+        std::vector<Coord> corners = {
+            apex,
+            apex + Coord(direction2D.x * cosHalfAngle - direction2D.y * sinHalfAngle, direction2D.x * sinHalfAngle + direction2D.y * cosHalfAngle) * sectorRadius,
+            apex + Coord(direction2D.x * cosHalfAngle + direction2D.y * sinHalfAngle, -direction2D.x * sinHalfAngle + direction2D.y * cosHalfAngle) * sectorRadius,
+        };
+        // The arc bulges beyond its end points wherever it crosses one of the axes
+        for (const Coord& axis : {Coord(1, 0), Coord(0, 1), Coord(-1, 0), Coord(0, -1)}) {
+            if (axis * direction2D >= cosHalfAngle) corners.push_back(apex + axis * sectorRadius);
+        }
+
+        Coord sectorMin = corners[0];
+        Coord sectorMax = corners[0];
+        for (const Coord& corner : corners) {
+            sectorMin = Coord(std::min(sectorMin.x, corner.x), std::min(sectorMin.y, corner.y));
+            sectorMax = Coord(std::max(sectorMax.x, corner.x), std::max(sectorMax.y, corner.y));
+        }
+        min = Coord(std::max(min.x, sectorMin.x), std::max(min.y, sectorMin.y));
+        max = Coord(std::min(max.x, sectorMax.x), std::min(max.y, sectorMax.y));
+    }
+
+    std::vector<int> result;
+    for (int id : queryBox(min, max)) {
+        if (cone.contains(txPos2D, direction2D, entries.at(id).pos)) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+int ConeGrid::toCellIndex(double value) const
+{
+    return static_cast<int>(std::floor(value / cellSize));
+}
+
+ConeGrid::CellKey ConeGrid::toCellKey(int cellX, int cellY) const
+{
+    return (static_cast<CellKey>(cellX) << 32) | static_cast<uint32_t>(cellY);
+}
+
+ConeGrid::CellKey ConeGrid::getCellKey(const Coord& pos) const
+{
+    return toCellKey(toCellIndex(pos.x), toCellIndex(pos.y));
+}
+
+void ConeGrid::insertIntoCell(CellKey cell, int id)
+{
+    cells[cell].push_back(id);
+}
+
+void ConeGrid::removeFromCell(CellKey cell, int id)
+{
+    auto it = cells.find(cell);
+    ASSERT(it != cells.end());
+
+    std::vector<int>& ids = it->second;
+    auto pos = std::find(ids.begin(), ids.end(), id);
+    ASSERT(pos != ids.end());
+    *pos = ids.back();
+    ids.pop_back();
+
+    if (ids.empty()) cells.erase(it);
+}
+
+std::vector<int> ConeGrid::queryBox(const Coord& min, const Coord& max) const
+{
+    std::vector<int> result;
+
+    // Boxes covering more cells than are occupied are cheaper to answer by visiting the occupied cells
+    bool bounded = std::isfinite(min.x) && std::isfinite(min.y) && std::isfinite(max.x) && std::isfinite(max.y);
+    double boxCells = bounded ? (std::floor(max.x / cellSize) - std::floor(min.x / cellSize) + 1) * (std::floor(max.y / cellSize) - std::floor(min.y / cellSize) + 1) : std::numeric_limits<double>::infinity();
+    if (boxCells > cells.size()) {
+        for (auto& cell : cells) {
+            // Same cells as below: the ones the box overlaps
+            double cellMinX = (cell.first >> 32) * cellSize;
+            double cellMinY = static_cast<int32_t>(static_cast<uint32_t>(cell.first)) * cellSize;
+            if (cellMinX + cellSize <= min.x || cellMinX > max.x || cellMinY + cellSize <= min.y || cellMinY > max.y) continue;
+            result.insert(result.end(), cell.second.begin(), cell.second.end());
+        }
+        return result;
+    }
+
+    for (int cellX = toCellIndex(min.x); cellX <= toCellIndex(max.x); ++cellX) {
+        for (int cellY = toCellIndex(min.y); cellY <= toCellIndex(max.y); ++cellY) {
+            auto it = cells.find(toCellKey(cellX, cellY));
+            if (it == cells.end()) continue;
+            result.insert(result.end(), it->second.begin(), it->second.end());
+        }
+    }
+    return result;
+}
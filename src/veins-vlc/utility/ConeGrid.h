@@ -0,0 +1,114 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins/base/utils/Coord.h"
+#include "veins-vlc/utility/TxCone.h"
+
+namespace veins {
+
+/**
+ * @brief Uniform grid in the x-y plane over the positions of NICs.
+ *
+ * NICs are identified by their id and moved between cells as their
+ * position is updated. Queries only visit the cells overlapping the
+ * bounding box of the queried region, which can be a disc or the
+ * oriented cone of a light module.
+ */
+class VEINS_VLC_API ConeGrid {
+public:
+    explicit ConeGrid(double cellSize = 1);
+
+    double getCellSize() const
+    {
+        return cellSize;
+    }
+
+    /**
+     * @brief Changes the size of the cells, moving all entries to
+     * their new cell
+     */
+    void setCellSize(double cellSize);
+
+    /**
+     * @brief Inserts the entry with the given id at pos, or moves it
+     * there if it is already known
+     */
+    void update(int id, const Coord& pos);
+
+    void remove(int id);
+
+    bool contains(int id) const;
+
+    /**
+     * @brief Returns the last position of a known entry
+     */
+    const Coord& getPosition(int id) const;
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    /**
+     * @brief Returns the ids of all entries within range of pos
+     */
+    std::vector<int> queryRange(const Coord& pos, double range) const;
+
+    /**
+     * @brief Returns the ids of all entries inside the cone of a light
+     * module at txPos facing into direction txDirection
+     */
+    std::vector<int> queryCone(const Coord& txPos, const Coord& txDirection, const TxCone& cone) const;
+
+protected:
+    using CellKey = int64_t;
+
+    struct Entry {
+        Coord pos;
+        CellKey cell;
+    };
+
+    double cellSize;
+    std::unordered_map<int, Entry> entries;
+    std::unordered_map<CellKey, std::vector<int>> cells;
+
+    int toCellIndex(double value) const;
+    CellKey toCellKey(int cellX, int cellY) const;
+    CellKey getCellKey(const Coord& pos) const;
+
+    void insertIntoCell(CellKey cell, int id);
+    void removeFromCell(CellKey cell, int id);
+
+    /**
+     * @brief Returns the ids of all entries in the cells overlapping
+     * the given box
+     */
+    std::vector<int> queryBox(const Coord& min, const Coord& max) const;
+};
+
+} // namespace veins
@@ -36,6 +36,13 @@ const int FIXED_REFERENCE_POWER_MW = 10; // unit mW; During empirical measuremen
 const int HEAD = 1;
 const int TAIL = -1;
 
+/*
+ * Indices of the apertures (light module and photodiode) of a
+ * PhyLayerVlcVehicle, which serves both ends of a vehicle
+ */
+const int APERTURE_HEAD = 0;
+const int APERTURE_TAIL = 1;
+
 /*
  * Consts for distinguishing between the left and right headlight
  * module in the Hella Light Model. Values solely serve as
@@ -66,17 +73,17 @@ const double PHY_VLC_SHR = 124; // bits; Minimum allowed length
  */
 const double PHY_VLC_HEADER = 32 + 26 + 0; // bits; Minimum possible length
 
-// XXX: the values below are not used
 /*
  * @brief Bitlength of the Phy Service Data Unit (PSDU)
  * It is specified between 0 - `aMaxPHYFrameSize` where aMaxPHyFrameSize
- * is given as 1023 for PHY I, and 65535 for PHY II, III in IEEE Std 802.15.7-2011,
+ * is given as 1023 octets for PHY I, and 65535 octets for PHY II, III in IEEE Std 802.15.7-2011,
  *
  * If MHR is modeled in the MAC, its size should be substracted from PSDU, because
  * the PSDU includes the MHR in the standard.
  */
-const double PHY_VLC_PSDU = 1023; // bits; Minimum possible length based on PHYs
+const double PHY_VLC_PSDU = 1023 * 8; // 8184 bits; Minimum possible length based on PHYs; limits fragments of MacLayerVlc
 
+// XXX: the value below is not used
 /*
  * @brief The Mac header (MHR).
  * According to Figure 44 from IEEE Std 802.15.7-2011 the value
@@ -84,6 +91,23 @@ const double PHY_VLC_PSDU = 1023; // bits; Minimum possible length based on PHYs
  */
 const double PHY_VLC_MHR = 21 * 8; // 168
 
+/*
+ * @brief Bitlength of the fields MacLayerVlc adds to each frame if it
+ * fragments messages: sequence number, fragment number and number of
+ * fragments, 8 bits each, which limits messages to 255 fragments
+ */
+const double MAC_VLC_FRAGMENT_HEADER = 24;
+const int MAC_VLC_MAX_FRAGMENTS = 255;
+
 // SHR, HEADER and PSDU form the Phy layer data unit (PPDU)
 
+/*
+ * @brief Wavelengths of the samples of the spectral emission of a
+ * RadiationPattern and the spectral response of a Photodiode:
+ * 380 nm to 750 nm in steps of 10 nm, i.e., 38 samples
+ */
+const double SPECTRAL_SAMPLES_FIRST_NM = 380;
+const double SPECTRAL_SAMPLES_STEP_NM = 10;
+const int SPECTRAL_SAMPLES = 38;
+
 } // namespace veins
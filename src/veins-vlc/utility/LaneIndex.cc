@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/LaneIndex.h"
+
+#include <algorithm>
+
+using namespace veins;
+
+void LaneIndex::clear()
+{
+    // keep the lanes (and their capacity), they will most likely be seen again
+    for (auto& lane : lanes) {
+        lane.clear();
+    }
+    entries.clear();
+}
+
+void LaneIndex::add(int hostId, const std::string& laneId, double lanePosition)
+{
+    auto inserted = laneIds.insert({laneId, static_cast<int>(lanes.size())});
+    if (inserted.second) lanes.emplace_back();
+
+    int lane = inserted.first->second;
+    lanes[lane].push_back(hostId);
+    entries[hostId] = {lane, lanePosition, 0};
+}
+
+void LaneIndex::build()
+{
+    for (auto& lane : lanes) {
+        std::sort(lane.begin(), lane.end(), [this](int a, int b) {
+            return entries.at(a).lanePosition < entries.at(b).lanePosition;
+        });
+        for (size_t rank = 0; rank < lane.size(); ++rank) {
+            entries.at(lane[rank]).rank = rank;
+        }
+    }
+}
+
+bool LaneIndex::contains(int hostId) const
+{
+    return entries.find(hostId) != entries.end();
+}
+
+bool LaneIndex::isSameLane(int hostIdA, int hostIdB) const
+{
+    auto a = entries.find(hostIdA);
+    auto b = entries.find(hostIdB);
+    if (a == entries.end() || b == entries.end()) return false;
+    return a->second.lane == b->second.lane;
+}
+
+size_t LaneIndex::countInBetween(int hostIdA, int hostIdB) const
+{
+    ASSERT(isSameLane(hostIdA, hostIdB));
+    size_t rankA = entries.at(hostIdA).rank;
+    size_t rankB = entries.at(hostIdB).rank;
+    size_t distance = rankA > rankB ? rankA - rankB : rankB - rankA;
+    return distance > 0 ? distance - 1 : 0;
+}
@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+/**
+ * @brief Order of the vehicles along each lane.
+ *
+ * Vehicles are identified by the id of their host module. After all
+ * vehicles of a time step have been added, build() sorts every lane
+ * by the position along it, so that neighborhood queries between two
+ * vehicles of the same lane take constant time.
+ */
+class VEINS_VLC_API LaneIndex {
+public:
+    /**
+     * @brief Removes all vehicles
+     */
+    void clear();
+
+    /**
+     * @brief Adds a vehicle at lanePosition (in m from the start) on laneId
+     */
+    void add(int hostId, const std::string& laneId, double lanePosition);
+
+    /**
+     * @brief Sorts the lanes; needs to be called before querying
+     */
+    void build();
+
+    bool contains(int hostId) const;
+
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    /**
+     * @brief Returns whether both vehicles are known and on the same lane
+     */
+    bool isSameLane(int hostIdA, int hostIdB) const;
+
+    /**
+     * @brief Returns the number of vehicles in between two vehicles of the
+     * same lane
+     */
+    size_t countInBetween(int hostIdA, int hostIdB) const;
+
+protected:
+    struct Entry {
+        int lane;
+        double lanePosition;
+        size_t rank;
+    };
+
+    std::unordered_map<std::string, int> laneIds;
+    std::vector<std::vector<int>> lanes;
+    std::unordered_map<int, Entry> entries;
+};
+
+} // namespace veins
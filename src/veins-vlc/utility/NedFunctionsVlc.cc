@@ -0,0 +1,41 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/veins-vlc.h"
+
+using namespace veins;
+
+namespace {
+
+cNedValue nedf_drawVlcEquipped(cComponent* context, cNedValue argv[], int argc)
+{
+    double penetrationRate = argv[0].doubleValue();
+    // Only draw if needed, so fully equipped runs consume no random numbers
+    if (penetrationRate >= 1) return true;
+    int rng = (argc > 1) ? static_cast<int>(argv[1].intValue()) : 0;
+    return context->getRNG(rng)->doubleRand() < penetrationRate;
+}
+
+} // namespace
+
+Define_NED_Function2(nedf_drawVlcEquipped,
+    "bool drawVlcEquipped(double penetrationRate, int rng?)",
+    "random/veins-vlc",
+    "Returns true with probability penetrationRate, drawing from the given RNG of the module (default 0) only if penetrationRate is below 1");
@@ -0,0 +1,146 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+/**
+ * @brief Statistics of an ObjectPool
+ */
+struct VEINS_VLC_API ObjectPoolStatistics {
+    /** @brief Number of objects allocated from the pool */
+    long allocations = 0;
+    /** @brief Number of allocations served from the free list */
+    long reuses = 0;
+    /** @brief Number of objects currently allocated */
+    long inUse = 0;
+    /** @brief Largest number of objects allocated at the same time */
+    long highWater = 0;
+
+    double getReuseRatio() const
+    {
+        return allocations > 0 ? static_cast<double>(reuses) / allocations : 0;
+    }
+};
+
+/**
+ * @brief Free list of memory blocks for objects of type T.
+ *
+ * Blocks of deleted objects are kept and handed out again on the next
+ * allocation, so the number of blocks only ever grows to the largest
+ * number of objects alive at the same time. Objects of types derived
+ * from T have a different size and bypass the pool.
+ *
+ * Simulations are single-threaded, so the pool is not synchronized.
+ */
+template <typename T>
+class ObjectPool {
+public:
+    static void* allocate(size_t size)
+    {
+        if (size != sizeof(T)) return ::operator new(size);
+
+        Storage& storage = getStorage();
+        ObjectPoolStatistics& statistics = storage.statistics;
+        ++statistics.allocations;
+        if (++statistics.inUse > statistics.highWater) statistics.highWater = statistics.inUse;
+
+        if (storage.freeList.empty()) return ::operator new(size);
+        ++statistics.reuses;
+        void* block = storage.freeList.back();
+        storage.freeList.pop_back();
+        return block;
+    }
+
+    static void deallocate(void* block, size_t size)
+    {
+        if (!block) return;
+        if (size != sizeof(T)) {
+            ::operator delete(block);
+            return;
+        }
+
+        Storage& storage = getStorage();
+        --storage.statistics.inUse;
+        storage.freeList.push_back(block);
+    }
+
+    static const ObjectPoolStatistics& getStatistics()
+    {
+        return getStorage().statistics;
+    }
+
+    /**
+     * @brief Resets the statistics (but not the objects in use), e.g., at the start of a run
+     */
+    static void resetStatistics()
+    {
+        ObjectPoolStatistics& statistics = getStorage().statistics;
+        long inUse = statistics.inUse;
+        statistics = ObjectPoolStatistics();
+        statistics.inUse = inUse;
+        statistics.highWater = inUse;
+    }
+
+protected:
+    struct Storage {
+        std::vector<void*> freeList;
+        ObjectPoolStatistics statistics;
+
+        ~Storage()
+        {
+            for (void* block : freeList) ::operator delete(block);
+        }
+    };
+
+    static Storage& getStorage()
+    {
+        static Storage storage;
+        return storage;
+    }
+};
+
+/**
+ * @brief Mixin which makes new and delete of T use its ObjectPool
+ *
+ * Usage: class Foo : public Base, public Pooled<Foo>
+ */
+template <typename T>
+class Pooled {
+public:
+    static void* operator new(size_t size)
+    {
+        return ObjectPool<T>::allocate(size);
+    }
+
+    static void operator delete(void* block, size_t size)
+    {
+        ObjectPool<T>::deallocate(block, size);
+    }
+};
+
+} // namespace veins
@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/OokPdrTable.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "veins-vlc/utility/Utils.h"
+
+using namespace veins;
+
+OokPdrTable::OokPdrTable(double minSnr_dB, double maxSnr_dB, double step_dB, size_t maxLengths)
+    : minSnr_dB(minSnr_dB)
+    , step_dB(step_dB)
+    , numSamples(static_cast<size_t>(std::round((maxSnr_dB - minSnr_dB) / step_dB)) + 1)
+    , maxLengths(maxLengths)
+{
+    ASSERT(maxSnr_dB > minSnr_dB && step_dB > 0);
+    rows.reserve(maxLengths);
+    bers.reserve(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        bers.push_back(getOokBer(std::pow(10, (minSnr_dB + i * step_dB) / 10)));
+    }
+}
+
+double OokPdrTable::getPdr(double snr, int packetLength)
+{
+    if (snr > 0) {
+        double x = (10 * std::log10(snr) - minSnr_dB) / step_dB;
+        if (x >= 0 && x < numSamples - 1) {
+            if (const Row* row = getRow(packetLength)) {
+                size_t i = static_cast<size_t>(x);
+                double fraction = x - i;
+                return row->pdr[i] + fraction * (row->pdr[i + 1] - row->pdr[i]);
+            }
+        }
+    }
+    return getOokPdr(snr, packetLength);
+}
+
+const OokPdrTable::Row* OokPdrTable::getRow(int packetLength)
+{
+    for (auto& row : rows) {
+        if (row.packetLength == packetLength) return &row;
+    }
+    if (rows.size() >= maxLengths) return nullptr;
+
+    Row row;
+    row.packetLength = packetLength;
+    row.pdr.reserve(numSamples);
+    for (double ber : bers) {
+        row.pdr.push_back(ber == 0.0 ? 1.0 : std::pow(1 - ber, static_cast<double>(packetLength)));
+    }
+    for (size_t i = 0; i + 1 < numSamples; ++i) {
+        double midSnr = std::pow(10, (minSnr_dB + (i + 0.5) * step_dB) / 10);
+        double interpolated = (row.pdr[i] + row.pdr[i + 1]) / 2;
+        errorBound = std::max(errorBound, std::fabs(interpolated - getOokPdr(midSnr, packetLength)));
+    }
+    rows.push_back(std::move(row));
+    return &rows.back();
+}
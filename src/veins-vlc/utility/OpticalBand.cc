@@ -0,0 +1,113 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/OpticalBand.h"
+
+#include "veins-vlc/utility/ConstsVlc.h"
+
+using namespace veins;
+
+namespace veins {
+
+namespace {
+
+const double SPEED_OF_LIGHT_M_S = 299792458;
+
+double parseWavelength(const std::string& wavelength, const std::string& token)
+{
+    size_t parsed = 0;
+    double value;
+    try {
+        value = std::stod(wavelength, &parsed);
+    }
+    catch (const std::exception&) {
+        parsed = 0;
+    }
+    if (parsed == 0 || parsed != wavelength.size()) {
+        throw cRuntimeError("Optical band '%s' of opticalBands is not of the form min-max", token.c_str());
+    }
+    return value;
+}
+
+} // namespace
+
+double OpticalBand::getCenterFrequency() const
+{
+    return SPEED_OF_LIGHT_M_S / ((minWavelength_nm + maxWavelength_nm) / 2 * 1e-9);
+}
+
+std::vector<OpticalBand> parseOpticalBands(const std::string& bands)
+{
+    std::vector<OpticalBand> result;
+    cStringTokenizer tokenizer(bands.c_str());
+    while (tokenizer.hasMoreTokens()) {
+        std::string token = tokenizer.nextToken();
+        size_t separator = token.find('-');
+        if (separator == std::string::npos) {
+            throw cRuntimeError("Optical band '%s' of opticalBands is not of the form min-max", token.c_str());
+        }
+        OpticalBand band;
+        band.minWavelength_nm = parseWavelength(token.substr(0, separator), token);
+        band.maxWavelength_nm = parseWavelength(token.substr(separator + 1), token);
+        if (band.minWavelength_nm >= band.maxWavelength_nm) {
+            throw cRuntimeError("Optical band '%s' of opticalBands is empty", token.c_str());
+        }
+        for (auto& other : result) {
+            if (band.minWavelength_nm < other.maxWavelength_nm && other.minWavelength_nm < band.maxWavelength_nm) {
+                throw cRuntimeError("Optical band '%s' of opticalBands overlaps with another band", token.c_str());
+            }
+        }
+        result.push_back(band);
+    }
+    return result;
+}
+
+double getBandResponsivityRatio(const std::vector<double>& emission, const std::vector<double>& response, const OpticalBand& band)
+{
+    if (emission.size() != response.size()) {
+        throw cRuntimeError("Spectral emission and spectral response vectors are not of same size!");
+    }
+
+    double sumEmission = 0;
+    double sumEmissionResponse = 0;
+    double sumBandEmission = 0;
+    double sumBandEmissionResponse = 0;
+    double sumBandResponse = 0;
+    size_t bandSamples = 0;
+    for (size_t i = 0; i < emission.size(); ++i) {
+        sumEmission += emission[i];
+        sumEmissionResponse += emission[i] * response[i];
+        if (band.contains(SPECTRAL_SAMPLES_FIRST_NM + i * SPECTRAL_SAMPLES_STEP_NM)) {
+            sumBandEmission += emission[i];
+            sumBandEmissionResponse += emission[i] * response[i];
+            sumBandResponse += response[i];
+            ++bandSamples;
+        }
+    }
+    if (bandSamples == 0 || sumEmissionResponse == 0) return 0;
+
+    // A light module of this band has the emission spectrum of the radiation pattern within it;
+    // without any emission there, assume a flat one
+    double bandResponsivity = (sumBandEmission > 0) ? sumBandEmissionResponse / sumBandEmission : sumBandResponse / bandSamples;
+    double responsivity = sumEmissionResponse / sumEmission;
+    return bandResponsivity / responsivity;
+}
+
+} // namespace veins
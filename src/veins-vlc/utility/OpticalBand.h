@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+/**
+ * @brief A band of wavelengths a VLC NIC sends and receives on,
+ * e.g., one of the color bands of IEEE Std 802.15.7-2011, Table 109
+ *
+ * Light modules are assumed to emit all of their power within their
+ * band, and photodiodes to ideally filter all other bands.
+ */
+struct VEINS_VLC_API OpticalBand {
+    double minWavelength_nm;
+    double maxWavelength_nm;
+
+    /** @brief Returns the frequency (in Hz) of the center wavelength */
+    double getCenterFrequency() const;
+
+    /** @brief Whether the sample at wavelength_nm belongs to the band */
+    bool contains(double wavelength_nm) const
+    {
+        return wavelength_nm >= minWavelength_nm && wavelength_nm < maxWavelength_nm;
+    }
+
+    bool operator==(const OpticalBand& other) const
+    {
+        return minWavelength_nm == other.minWavelength_nm && maxWavelength_nm == other.maxWavelength_nm;
+    }
+};
+
+/**
+ * @brief Parses a space separated list of bands, given as "min-max" in nm
+ *
+ * Throws a cRuntimeError naming the opticalBands parameter for malformed
+ * or overlapping bands.
+ */
+VEINS_VLC_API std::vector<OpticalBand> parseOpticalBands(const std::string& bands);
+
+/**
+ * @brief Returns the responsivity of a photodiode to the emission of
+ * a light module within band, relative to the one of its whole spectrum
+ *
+ * emission and response are sampled as described by SPECTRAL_SAMPLES_FIRST_NM,
+ * SPECTRAL_SAMPLES_STEP_NM and SPECTRAL_SAMPLES.
+ */
+VEINS_VLC_API double getBandResponsivityRatio(const std::vector<double>& emission, const std::vector<double>& response, const OpticalBand& band);
+
+} // namespace veins
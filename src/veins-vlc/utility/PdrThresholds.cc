@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/PdrThresholds.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace veins;
+
+PdrThresholds::PdrThresholds(PdrFunction pdr, double targetPdr)
+    : pdr(pdr)
+    , targetPdr(targetPdr)
+{
+}
+
+double PdrThresholds::getThreshold(int packetLength)
+{
+    auto it = thresholds.find(packetLength);
+    if (it != thresholds.end()) return it->second;
+
+    double threshold = calcThreshold(packetLength);
+    thresholds.emplace(packetLength, threshold);
+    return threshold;
+}
+
+double PdrThresholds::calcThreshold(int packetLength) const
+{
+    auto pdrAt = [this, packetLength](double snr_dB) {
+        return pdr(std::pow(10, snr_dB / 10), packetLength);
+    };
+
+    double low_dB = -30;
+    double high_dB = 60;
+    if (pdrAt(high_dB) < targetPdr) return std::numeric_limits<double>::infinity();
+    if (pdrAt(low_dB) >= targetPdr) return std::pow(10, low_dB / 10);
+
+    // pdr(low) < targetPdr <= pdr(high)
+    while (high_dB - low_dB > 1e-6) {
+        double middle_dB = (low_dB + high_dB) / 2;
+        if (pdrAt(middle_dB) < targetPdr) {
+            low_dB = middle_dB;
+        }
+        else {
+            high_dB = middle_dB;
+        }
+    }
+    return std::pow(10, high_dB / 10);
+}
@@ -0,0 +1,66 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <functional>
+#include <map>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+/**
+ * @brief SNR thresholds at which a PDR function reaches a target PDR
+ *
+ * Replaces drawing bit errors by comparing the SNR of a packet against
+ * the smallest SNR at which packets of its length are received with at
+ * least the target PDR. The threshold of each length is searched for
+ * (by bisection over the SNR in dB) on its first use.
+ */
+class VEINS_VLC_API PdrThresholds {
+public:
+    /** @brief Probability to receive packetLength bits at the given SNR (linear) without error */
+    using PdrFunction = std::function<double(double snr, int packetLength)>;
+
+    /** @brief pdr needs to increase monotonically with the SNR */
+    PdrThresholds(PdrFunction pdr, double targetPdr);
+
+    /**
+     * @brief Returns the smallest SNR (linear, to 1e-6 dB) at which pdr
+     * reaches targetPdr for packets of packetLength bits; infinity if it
+     * does not below 60 dB
+     */
+    double getThreshold(int packetLength);
+
+    double getTargetPdr() const
+    {
+        return targetPdr;
+    }
+
+protected:
+    PdrFunction pdr;
+    double targetPdr;
+    std::map<int, double> thresholds;
+
+    double calcThreshold(int packetLength) const;
+};
+
+} // namespace veins
@@ -0,0 +1,77 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/PhyModesVlc.h"
+
+using namespace veins;
+
+namespace veins {
+
+namespace {
+
+const std::vector<VlcPhyMode> phyModes = {
+    // PHY I, OOK with Manchester coding at 200 kHz: 11.67, 24.44, 48.89, 73.3 and 100 kb/s
+    {1, VlcModulation::OOK, 200e3, 1.0 / 2, 15, 7, 4, 1.0 / 4, 4},
+    {1, VlcModulation::OOK, 200e3, 1.0 / 2, 15, 11, 4, 1.0 / 3, 4},
+    {1, VlcModulation::OOK, 200e3, 1.0 / 2, 15, 11, 4, 2.0 / 3, 3},
+    {1, VlcModulation::OOK, 200e3, 1.0 / 2, 15, 11, 4, 1, 0},
+    {1, VlcModulation::OOK, 200e3, 1.0 / 2, 0, 0, 0, 1, 0},
+    // PHY I, VPPM with 4B6B coding at 400 kHz: 35.56, 71.11, 124.4 and 266.6 kb/s
+    {1, VlcModulation::VPPM, 400e3, 4.0 / 6, 15, 2, 4, 1, 0},
+    {1, VlcModulation::VPPM, 400e3, 4.0 / 6, 15, 4, 4, 1, 0},
+    {1, VlcModulation::VPPM, 400e3, 4.0 / 6, 15, 7, 4, 1, 0},
+    {1, VlcModulation::VPPM, 400e3, 4.0 / 6, 0, 0, 0, 1, 0},
+    // PHY II, VPPM with 4B6B coding at 3.75 and 7.5 MHz: 1.25, 2, 2.5 and 4 Mb/s
+    {2, VlcModulation::VPPM, 3.75e6, 4.0 / 6, 64, 32, 8, 1, 0},
+    {2, VlcModulation::VPPM, 3.75e6, 4.0 / 6, 160, 128, 8, 1, 0},
+    {2, VlcModulation::VPPM, 7.5e6, 4.0 / 6, 64, 32, 8, 1, 0},
+    {2, VlcModulation::VPPM, 7.5e6, 4.0 / 6, 160, 128, 8, 1, 0},
+    // PHY II, OOK with 8B10B coding at 15 and 120 MHz: 6 and 96 Mb/s
+    {2, VlcModulation::OOK, 15e6, 8.0 / 10, 64, 32, 8, 1, 0},
+    {2, VlcModulation::OOK, 120e6, 8.0 / 10, 0, 0, 0, 1, 0},
+};
+
+} // namespace
+
+double VlcPhyMode::getDataRate() const
+{
+    double rsRate = rsN > 0 ? double(rsK) / rsN : 1;
+    return opticalClock * rllRate * rsRate * ccRate;
+}
+
+const std::vector<VlcPhyMode>& getVlcPhyModes()
+{
+    return phyModes;
+}
+
+const VlcPhyMode& getVlcPhyMode(int id)
+{
+    if (id < 0 || id >= static_cast<int>(phyModes.size())) {
+        throw cRuntimeError("Unknown VLC PHY mode %d", id);
+    }
+    return phyModes[id];
+}
+
+double getVlcPhyModeSnr(const VlcPhyMode& mode, double sinr, double referenceBitrate)
+{
+    return sinr * referenceBitrate / mode.opticalClock;
+}
+
+} // namespace veins
@@ -0,0 +1,88 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+enum class VlcModulation {
+    OOK,
+    VPPM
+};
+
+/**
+ * @brief Operating mode of the IEEE 802.15.7 PHY
+ *
+ * The data rate is derived from the optical clock and the rates of the
+ * run length limited (RLL) line code and the outer Reed-Solomon and
+ * inner convolutional codes, as in IEEE Std 802.15.7-2011, Table 73
+ * (PHY I) and Table 74 (PHY II).
+ */
+struct VEINS_VLC_API VlcPhyMode {
+    /** @brief 1 for PHY I, 2 for PHY II */
+    int phyType;
+    VlcModulation modulation;
+    /** @brief Optical clock in Hz, i.e., the chip rate */
+    double opticalClock;
+    /** @brief Rate of the RLL code, e.g., 1/2 for Manchester */
+    double rllRate;
+    /** @brief Length and dimension of the RS(n, k) code, 0 if none */
+    int rsN;
+    int rsK;
+    /** @brief Bits per RS symbol */
+    int rsBits;
+    /** @brief Rate of the inner convolutional code, 1 if none */
+    double ccRate;
+    /** @brief Asymptotic hard-decision coding gain of the convolutional code in dB */
+    double ccGain_dB;
+
+    /** @brief Data rate in bit/s */
+    double getDataRate() const;
+};
+
+/**
+ * @brief All supported operating modes; the index is the mode id
+ *
+ * Within each PHY type, modes of the same modulation are sorted by
+ * ascending data rate.
+ */
+VEINS_VLC_API const std::vector<VlcPhyMode>& getVlcPhyModes();
+
+/**
+ * @brief Returns the operating mode with the given id
+ *
+ * Throws a cRuntimeError for unknown ids.
+ */
+VEINS_VLC_API const VlcPhyMode& getVlcPhyMode(int id);
+
+/**
+ * @brief Returns the chip SNR of mode, given the SINR at the reference bitrate
+ *
+ * The noise floor of the PHY is configured for a receiver bandwidth
+ * equal to its bitrate parameter, so faster optical clocks collect
+ * proportionally more noise.
+ */
+VEINS_VLC_API double getVlcPhyModeSnr(const VlcPhyMode& mode, double sinr, double referenceBitrate);
+
+} // namespace veins
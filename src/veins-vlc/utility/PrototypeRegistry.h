@@ -0,0 +1,88 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "veins-vlc/veins-vlc.h"
+
+namespace veins {
+
+/**
+ * @brief Immutable objects derived from a configuration, shared by all
+ * modules with the same one.
+ *
+ * Each prototype is created once per key, which needs to capture every
+ * input it is derived from (e.g., the type and parameters of an analogue
+ * model). Modules inserted later, e.g., NICs of vehicles entering the
+ * simulation, get the existing prototype instead of parsing and deriving
+ * it again, and either share it or clone it.
+ *
+ * Prototypes are never modified and must not refer to modules, as they
+ * outlive the module which created them.
+ */
+template <typename T>
+class PrototypeRegistry {
+public:
+    /**
+     * @brief Returns the prototype for key, creating it with create()
+     * (which returns a std::shared_ptr<T>) if there is none yet
+     */
+    template <typename Create>
+    std::shared_ptr<T> get(const std::string& key, Create create)
+    {
+        auto it = prototypes.find(key);
+        if (it != prototypes.end()) {
+            ++hits;
+            return it->second;
+        }
+        ++misses;
+        std::shared_ptr<T> prototype = create();
+        prototypes.emplace(key, prototype);
+        return prototype;
+    }
+
+    size_t size() const
+    {
+        return prototypes.size();
+    }
+
+    /** @brief Number of calls of get() served by an existing prototype */
+    long getHits() const
+    {
+        return hits;
+    }
+
+    /** @brief Number of prototypes created */
+    long getMisses() const
+    {
+        return misses;
+    }
+
+protected:
+    std::map<std::string, std::shared_ptr<T>> prototypes;
+    long hits = 0;
+    long misses = 0;
+};
+
+} // namespace veins
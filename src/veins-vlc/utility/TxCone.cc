@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/TxCone.h"
+
+#include <algorithm>
+
+using namespace veins;
+
+// Tolerance for receivers exactly on the border of the cone; the light models
+// compute the same test in a slightly different order of operations
+static const double CONE_EPSILON = 1e-9;
+
+bool TxCone::contains(const Coord& txPos, const Coord& txDirection, const Coord& rxPos) const
+{
+    const Coord txPos2D = txPos.atZ(0);
+    const Coord rxPos2D = rxPos.atZ(0);
+
+    if (txPos2D.distance(rxPos2D) > range) return false;
+    if (halfAngle >= M_PI) return true;
+
+    const Coord apex2RxVector = rxPos2D - (txPos2D - txDirection.atZ(0) * apexOffset);
+    double apex2RxDistance = apex2RxVector.length();
+    if (apex2RxDistance == 0) return true;
+
+    // Same as the FOV check of the light models: angle between heading and apex->Rx within halfAngle
+    return apex2RxVector * txDirection >= apex2RxDistance * cos(halfAngle) - CONE_EPSILON;
+}
+
+double TxCone::getBoundaryDistance(const Coord& txPos, const Coord& txDirection, const Coord& rxPos) const
+{
+    const Coord txPos2D = txPos.atZ(0);
+    const Coord rxPos2D = rxPos.atZ(0);
+
+    // Distance to the circle bounding the range
+    double tx2RxDistance = txPos2D.distance(rxPos2D);
+    bool inRange = tx2RxDistance <= range;
+    double rangeDistance = std::fabs(range - tx2RxDistance);
+
+    // Distance to the rays bounding the cone
+    bool inAngle = true;
+    double angleDistance = std::numeric_limits<double>::infinity();
+    if (halfAngle < M_PI) {
+        const Coord apex2RxVector = rxPos2D - (txPos2D - txDirection.atZ(0) * apexOffset);
+        double apex2RxDistance = apex2RxVector.length();
+        double angle = 0;
+        if (apex2RxDistance > 0) angle = acos(std::max(-1.0, std::min(1.0, apex2RxVector * txDirection / apex2RxDistance)));
+        inAngle = angle <= halfAngle;
+
+        // Beyond a right angle to the nearest ray, the apex is the closest point of the boundary
+        double angleToBoundary = std::fabs(angle - halfAngle);
+        angleDistance = angleToBoundary < M_PI / 2 ? apex2RxDistance * sin(angleToBoundary) : apex2RxDistance;
+    }
+
+    if (inRange && inAngle) return std::min(rangeDistance, angleDistance);
+
+    double distance = 0;
+    if (!inRange) distance = std::max(distance, rangeDistance);
+    if (!inAngle) distance = std::max(distance, angleDistance);
+    return distance;
+}
@@ -0,0 +1,68 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins/base/utils/Coord.h"
+
+namespace veins {
+
+/**
+ * @brief Region in the x-y plane which a light module can illuminate.
+ *
+ * The region is a cone around the direction the module is facing,
+ * bounded by a maximum range. Outside of it the light models
+ * attenuate the signal to zero, so receivers there need not be
+ * connected to the transmitter at all.
+ *
+ * The apex of the cone may lie behind the module position, which
+ * covers light modules made of several laterally offset LEDs.
+ */
+class VEINS_VLC_API TxCone {
+public:
+    /** @brief Half-angle of the cone in rad; M_PI if the module is not limited in angle */
+    double halfAngle = M_PI;
+    /** @brief Distance in m from the module position beyond which no power is received */
+    double range = std::numeric_limits<double>::infinity();
+    /** @brief Distance in m by which the apex lies behind the module position */
+    double apexOffset = 0;
+
+    /**
+     * @brief Returns whether rxPos lies in the cone of a module at
+     * txPos facing into direction txDirection (unit vector).
+     */
+    bool contains(const Coord& txPos, const Coord& txDirection, const Coord& rxPos) const;
+
+    /**
+     * @brief Returns how far rxPos has to move relative to the module
+     * (in the x-y plane) before contains() can change its result.
+     *
+     * This is a lower bound: the distance to the boundary of the cone
+     * if rxPos lies inside, or to the violated constraints otherwise.
+     */
+    double getBoundaryDistance(const Coord& txPos, const Coord& txDirection, const Coord& rxPos) const;
+};
+
+} // namespace veins
@@ -20,6 +20,10 @@
 
 #include "veins-vlc/utility/Utils.h"
 
+#include "veins-vlc/utility/PhyModesVlc.h"
+
+#include <algorithm>
+
 using namespace veins;
 
 namespace veins {
@@ -130,4 +134,49 @@ double getOokPdr(double snr, int packetLength)
     return std::pow(1 - ber, (double) packetLength);
 }
 
+double getVppmBer(double snr)
+{
+    // Like 2-PPM, the decision compares the two slots of a chip, so
+    // their difference is the full amplitude, disturbed by the noise
+    // of both: Q-func(sqrt(2 * snr)), 3 dB ahead of OOK
+    return 0.5 * erfc(std::sqrt(snr));
+}
+
+double getVlcPhyModeBer(const VlcPhyMode& mode, double snr)
+{
+    // The convolutional code is approximated by its coding gain;
+    // the RLL code does not correct errors and the chip errors are
+    // not multiplied by its decoding
+    snr *= std::pow(10, mode.ccGain_dB / 10);
+    double ber = (mode.modulation == VlcModulation::VPPM) ? getVppmBer(snr) : getOokBer(snr);
+    if (mode.rsN == 0 || ber == 0.0) {
+        return ber;
+    }
+
+    // Reed-Solomon code correcting t symbol errors per codeword:
+    // bit error rate of bounded distance decoding with independent symbol errors
+    int n = mode.rsN;
+    int t = (mode.rsN - mode.rsK) / 2;
+    double ser = 1 - std::pow(1 - ber, mode.rsBits);
+    if (ser >= 1) return 0.5;
+    double sum = 0;
+    for (int i = t + 1; i <= n; ++i) {
+        double logBinomial = std::lgamma(n + 1.0) - std::lgamma(i + 1.0) - std::lgamma(n - i + 1.0);
+        sum += i * std::exp(logBinomial + i * std::log(ser) + (n - i) * std::log1p(-ser));
+    }
+    double bitsPerSymbolError = std::pow(2, mode.rsBits - 1) / (std::pow(2, mode.rsBits) - 1);
+    return std::min(0.5, bitsPerSymbolError * sum / n);
+}
+
+double getVlcPhyModePdr(const VlcPhyMode& mode, double snr, int packetLength)
+{
+    double ber = getVlcPhyModeBer(mode, snr);
+
+    if (ber == 0.0) {
+        return 1.0;
+    }
+
+    return std::pow(1 - ber, (double) packetLength);
+}
+
 } // namespace veins
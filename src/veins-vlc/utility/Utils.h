@@ -68,4 +68,14 @@ double getOokBer(double snr);
 
 double getOokPdr(double snr, int packetLength);
 
+// Return BER of VPPM at the given SNR, detected by comparing both slots of each chip.
+double getVppmBer(double snr);
+
+struct VlcPhyMode;
+
+// Return BER after decoding the line and FEC codes of mode at the given chip SNR.
+double getVlcPhyModeBer(const VlcPhyMode& mode, double snr);
+
+double getVlcPhyModePdr(const VlcPhyMode& mode, double snr, int packetLength);
+
 } // namespace veins
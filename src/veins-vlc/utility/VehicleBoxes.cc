@@ -0,0 +1,155 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "veins-vlc/utility/VehicleBoxes.h"
+
+#include <cmath>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace veins;
+
+void VehicleBoxes::clear()
+{
+    count = 0;
+    centerX.clear();
+    centerY.clear();
+    axisX.clear();
+    axisY.clear();
+    halfLength.clear();
+    halfWidth.clear();
+    ids.clear();
+}
+
+void VehicleBoxes::add(int id, const Coord& frontPos, const Coord& direction, double length, double width)
+{
+    ASSERT(id >= 0);
+
+    // Overwrite the first padding box, if any
+    if (count < ids.size()) {
+        size_t padding = ids.size() - count;
+        for (auto array : {&centerX, &centerY, &axisX, &axisY, &halfLength, &halfWidth, &ids}) {
+            array->resize(array->size() - padding);
+        }
+    }
+
+    push(frontPos.x - direction.x * length / 2, frontPos.y - direction.y * length / 2, direction.x, direction.y, length / 2, width / 2, id);
+    ++count;
+
+    // Padding boxes have a negative size, so they are separated from any segment
+    while (ids.size() % BLOCK_SIZE != 0) {
+        push(0, 0, 1, 0, -1, -1, -1);
+    }
+}
+
+void VehicleBoxes::push(double cx, double cy, double ax, double ay, double hl, double hw, double id)
+{
+    centerX.push_back(cx);
+    centerY.push_back(cy);
+    axisX.push_back(ax);
+    axisY.push_back(ay);
+    halfLength.push_back(hl);
+    halfWidth.push_back(hw);
+    ids.push_back(id);
+}
+
+// Separating axis test of a segment (midpoint m, half vector h, normal n) against a box:
+// the box is missed iff it is separated along its length, its width, or the normal of the segment.
+bool VehicleBoxes::isBlockedScalar(const Coord& senderPos, const Coord& receiverPos, int senderId, int receiverId) const
+{
+    const double mx = (senderPos.x + receiverPos.x) / 2;
+    const double my = (senderPos.y + receiverPos.y) / 2;
+    const double hx = (receiverPos.x - senderPos.x) / 2;
+    const double hy = (receiverPos.y - senderPos.y) / 2;
+    const double nx = -hy;
+    const double ny = hx;
+
+    for (size_t i = 0; i < count; ++i) {
+        if (ids[i] == senderId || ids[i] == receiverId) continue;
+
+        const double dx = mx - centerX[i];
+        const double dy = my - centerY[i];
+        const double ux = axisX[i];
+        const double uy = axisY[i];
+        const double vx = -uy;
+        const double vy = ux;
+
+        if (std::fabs(dx * ux + dy * uy) > halfLength[i] + std::fabs(hx * ux + hy * uy)) continue;
+        if (std::fabs(dx * vx + dy * vy) > halfWidth[i] + std::fabs(hx * vx + hy * vy)) continue;
+        if (std::fabs(dx * nx + dy * ny) > halfLength[i] * std::fabs(ux * nx + uy * ny) + halfWidth[i] * std::fabs(vx * nx + vy * ny)) continue;
+
+        return true;
+    }
+    return false;
+}
+
+#if defined(__AVX2__)
+
+bool VehicleBoxes::isBlocked(const Coord& senderPos, const Coord& receiverPos, int senderId, int receiverId) const
+{
+    const __m256d mx = _mm256_set1_pd((senderPos.x + receiverPos.x) / 2);
+    const __m256d my = _mm256_set1_pd((senderPos.y + receiverPos.y) / 2);
+    const __m256d hx = _mm256_set1_pd((receiverPos.x - senderPos.x) / 2);
+    const __m256d hy = _mm256_set1_pd((receiverPos.y - senderPos.y) / 2);
+    const __m256d nx = _mm256_set1_pd(-(receiverPos.y - senderPos.y) / 2);
+    const __m256d ny = hx;
+    const __m256d sender = _mm256_set1_pd(senderId);
+    const __m256d receiver = _mm256_set1_pd(receiverId);
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+
+    auto abs = [&signMask](__m256d value) {
+        return _mm256_andnot_pd(signMask, value);
+    };
+    auto dot = [](__m256d ax, __m256d ay, __m256d bx, __m256d by) {
+        return _mm256_add_pd(_mm256_mul_pd(ax, bx), _mm256_mul_pd(ay, by));
+    };
+
+    for (size_t i = 0; i < ids.size(); i += BLOCK_SIZE) {
+        const __m256d dx = _mm256_sub_pd(mx, _mm256_loadu_pd(&centerX[i]));
+        const __m256d dy = _mm256_sub_pd(my, _mm256_loadu_pd(&centerY[i]));
+        const __m256d ux = _mm256_loadu_pd(&axisX[i]);
+        const __m256d uy = _mm256_loadu_pd(&axisY[i]);
+        const __m256d vx = _mm256_xor_pd(uy, signMask);
+        const __m256d vy = ux;
+        const __m256d hl = _mm256_loadu_pd(&halfLength[i]);
+        const __m256d hw = _mm256_loadu_pd(&halfWidth[i]);
+        const __m256d id = _mm256_loadu_pd(&ids[i]);
+
+        __m256d separated = _mm256_cmp_pd(abs(dot(dx, dy, ux, uy)), _mm256_add_pd(hl, abs(dot(hx, hy, ux, uy))), _CMP_GT_OQ);
+        separated = _mm256_or_pd(separated, _mm256_cmp_pd(abs(dot(dx, dy, vx, vy)), _mm256_add_pd(hw, abs(dot(hx, hy, vx, vy))), _CMP_GT_OQ));
+        separated = _mm256_or_pd(separated, _mm256_cmp_pd(abs(dot(dx, dy, nx, ny)), _mm256_add_pd(_mm256_mul_pd(hl, abs(dot(ux, uy, nx, ny))), _mm256_mul_pd(hw, abs(dot(vx, vy, nx, ny)))), _CMP_GT_OQ));
+        separated = _mm256_or_pd(separated, _mm256_cmp_pd(id, sender, _CMP_EQ_OQ));
+        separated = _mm256_or_pd(separated, _mm256_cmp_pd(id, receiver, _CMP_EQ_OQ));
+
+        if (_mm256_movemask_pd(separated) != 0xf) return true;
+    }
+    return false;
+}
+
+#else
+
+bool VehicleBoxes::isBlocked(const Coord& senderPos, const Coord& receiverPos, int senderId, int receiverId) const
+{
+    return isBlockedScalar(senderPos, receiverPos, senderId, receiverId);
+}
+
+#endif
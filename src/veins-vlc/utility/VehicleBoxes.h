@@ -0,0 +1,90 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#pragma once
+
+#include <vector>
+
+#include "veins-vlc/veins-vlc.h"
+
+#include "veins/base/utils/Coord.h"
+
+namespace veins {
+
+/**
+ * @brief Outlines of all vehicles in the x-y plane, stored as a
+ * structure of arrays for testing a line of sight against all of
+ * them at once.
+ *
+ * If built with AVX2 (see src/makefrag), four boxes are tested per
+ * instruction; otherwise, the same test runs one box at a time.
+ */
+class VEINS_VLC_API VehicleBoxes {
+public:
+    /**
+     * @brief Removes all boxes
+     */
+    void clear();
+
+    /**
+     * @brief Adds the box of a vehicle whose front bumper is at frontPos
+     *
+     * @param id id of the host of the vehicle, needs to be non-negative
+     * @param direction unit vector the vehicle is facing
+     */
+    void add(int id, const Coord& frontPos, const Coord& direction, double length, double width);
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * @brief Returns whether the segment between senderPos and
+     * receiverPos intersects any box other than those of the vehicles
+     * senderId and receiverId
+     */
+    bool isBlocked(const Coord& senderPos, const Coord& receiverPos, int senderId = -1, int receiverId = -1) const;
+
+    /**
+     * @brief Same as isBlocked, but never uses SIMD instructions
+     */
+    bool isBlockedScalar(const Coord& senderPos, const Coord& receiverPos, int senderId = -1, int receiverId = -1) const;
+
+protected:
+    /** @brief Number of boxes in a block; the arrays are padded to whole blocks */
+    static const size_t BLOCK_SIZE = 4;
+
+    size_t count = 0;
+
+    // Center, unit vector along the length, and half the size of every box
+    std::vector<double> centerX;
+    std::vector<double> centerY;
+    std::vector<double> axisX;
+    std::vector<double> axisY;
+    std::vector<double> halfLength;
+    std::vector<double> halfWidth;
+    /** @brief Host ids as doubles (exact for all ids) so they can be compared in SIMD registers */
+    std::vector<double> ids;
+
+    void push(double cx, double cy, double ax, double ay, double hl, double hw, double id);
+};
+
+} // namespace veins
@@ -0,0 +1,142 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <algorithm>
+#include <limits>
+
+#include "catch2/catch.hpp"
+#include "veins/base/utils/Coord.h"
+#include "veins-vlc/utility/ConeGrid.h"
+#include "veins-vlc/utility/Utils.h"
+
+using namespace veins;
+
+static std::vector<int> sorted(std::vector<int> ids)
+{
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+SCENARIO("ConeGrid finds the NICs inside the cone of a light module", "[coneGrid]")
+{
+    GIVEN("A headlight at the origin facing east and NICs around it")
+    {
+        ConeGrid grid(30);
+        grid.update(1, Coord(20, 0));
+        grid.update(2, Coord(100, 50));
+        grid.update(3, Coord(100, 150));
+        grid.update(4, Coord(-20, 0));
+        grid.update(5, Coord(400, 0));
+
+        TxCone cone;
+        cone.halfAngle = deg2rad(45);
+        cone.range = 337;
+
+        WHEN("Querying the cone")
+        {
+            auto ids = sorted(grid.queryCone(Coord(0, 0), Coord(1, 0), cone));
+            THEN("Only the NICs in front, within the angle and the range are found")
+            {
+                REQUIRE(ids == std::vector<int>({1, 2}));
+            }
+        }
+        WHEN("The headlight faces north")
+        {
+            auto ids = sorted(grid.queryCone(Coord(0, 0), Coord(0, 1), cone));
+            THEN("The NIC to the north-east is found")
+            {
+                REQUIRE(ids == std::vector<int>({3}));
+            }
+        }
+        WHEN("A NIC moves behind the headlight")
+        {
+            grid.update(2, Coord(-100, 50));
+            auto ids = sorted(grid.queryCone(Coord(0, 0), Coord(1, 0), cone));
+            THEN("It is no longer found")
+            {
+                REQUIRE(ids == std::vector<int>({1}));
+            }
+        }
+        WHEN("The apex of the cone lies behind the light module")
+        {
+            cone.apexOffset = 10;
+            grid.update(6, Coord(1, 10));
+            auto ids = sorted(grid.queryCone(Coord(0, 0), Coord(1, 0), cone));
+            THEN("A NIC right next to it is found, but none behind the apex")
+            {
+                REQUIRE(ids == std::vector<int>({1, 2, 6}));
+            }
+        }
+        WHEN("Querying a range and shrinking the cells")
+        {
+            grid.setCellSize(7);
+            auto ids = sorted(grid.queryRange(Coord(0, 0), 30));
+            THEN("All NICs within range are found")
+            {
+                REQUIRE(ids == std::vector<int>({1, 4}));
+            }
+        }
+        WHEN("Querying an unbounded range")
+        {
+            auto ids = sorted(grid.queryRange(Coord(0, 0), std::numeric_limits<double>::infinity()));
+            THEN("The NICs of all cells are found")
+            {
+                REQUIRE(ids == std::vector<int>({1, 2, 3, 4, 5}));
+            }
+        }
+        WHEN("Removing a NIC")
+        {
+            grid.remove(1);
+            THEN("It is no longer found")
+            {
+                REQUIRE(grid.size() == 4);
+                REQUIRE(sorted(grid.queryRange(Coord(0, 0), 30)) == std::vector<int>({4}));
+            }
+        }
+    }
+}
+
+SCENARIO("TxCone tells how far a receiver is from changing its link", "[coneGrid]")
+{
+    GIVEN("A headlight at the origin facing east")
+    {
+        TxCone cone;
+        cone.halfAngle = deg2rad(45);
+        cone.range = 100;
+
+        WHEN("The receiver is straight ahead")
+        {
+            THEN("It is closest to the end of the range or to the border of the cone")
+            {
+                REQUIRE(cone.getBoundaryDistance(Coord(0, 0), Coord(1, 0), Coord(90, 0)) == Approx(10));
+                REQUIRE(cone.getBoundaryDistance(Coord(0, 0), Coord(1, 0), Coord(20, 0)) == Approx(20 * sin(deg2rad(45))));
+            }
+        }
+        WHEN("The receiver is outside")
+        {
+            THEN("The distance to the violated constraints is returned")
+            {
+                REQUIRE(cone.getBoundaryDistance(Coord(0, 0), Coord(1, 0), Coord(150, 0)) == Approx(50));
+                REQUIRE(cone.getBoundaryDistance(Coord(0, 0), Coord(1, 0), Coord(0, 20)) == Approx(20 * sin(deg2rad(45))));
+                REQUIRE(cone.getBoundaryDistance(Coord(0, 0), Coord(1, 0), Coord(-20, 0)) == Approx(20));
+            }
+        }
+    }
+}
@@ -0,0 +1,231 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "testutils/Component.h"
+#include "testutils/Simulation.h"
+#include "veins-vlc/DeciderVlc.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace veins;
+
+namespace {
+
+class PhyStub : public DeciderToPhyInterface {
+public:
+    std::map<std::string, double> scalars;
+    int framesSentUp = 0;
+
+    void getChannelInfo(simtime_t_cref from, simtime_t_cref to, AirFrameVector& out) override
+    {
+    }
+    double getNoiseFloorValue() override
+    {
+        return 1e-9;
+    }
+    void sendControlMsgToMac(cMessage* msg) override
+    {
+        delete msg;
+    }
+    void sendUp(AirFrame* frame, DeciderResult* result) override
+    {
+        ++framesSentUp;
+        delete result;
+    }
+    simtime_t getSimTime() override
+    {
+        return simTime();
+    }
+    void recordScalar(const char* name, double value, const char* unit = nullptr) override
+    {
+        scalars[name] = value;
+    }
+
+    // not used by DeciderVlc
+    void cancelScheduledMessage(cMessage* msg)
+    {
+    }
+    void rescheduleMessage(cMessage* msg, simtime_t_cref t)
+    {
+    }
+    void drawCurrent(double amount, int activity)
+    {
+    }
+    BaseWorldUtility* getWorldUtility()
+    {
+        return nullptr;
+    }
+};
+
+class DeciderVlcUnderTest : public DeciderVlc {
+public:
+    using DeciderVlc::DeciderVlc;
+    using DeciderVlc::processNewSignal;
+    using DeciderVlc::processSignalEnd;
+
+    double getChannelPower() const
+    {
+        return channelPower;
+    }
+
+    AirFrame* getSyncedFrame() const
+    {
+        return currentSignal.first;
+    }
+
+    double getSyncedInterference() const
+    {
+        return syncedInterference.back().second;
+    }
+};
+
+AirFrameVlc* createFrame(double power)
+{
+    Signal signal(Spectrum({666e12}), 0, 1e-3);
+    signal.at(0) = power;
+    signal.setDataStart(0);
+    signal.setDataEnd(0);
+    signal.setCenterFrequencyIndex(0);
+
+    AirFrameVlc* frame = new AirFrameVlc();
+    frame->setSignal(signal);
+    frame->setReceivedPower(power);
+    frame->setBitLength(800);
+    return frame;
+}
+
+} // namespace
+
+SCENARIO("DeciderVlc sums up the power of overlapping frames as they start and end", "[deciderVlc]")
+{
+    DummySimulation ds(new omnetpp::cNullEnvir(0, nullptr, nullptr));
+    DummyComponent owner(&ds);
+    PhyStub phy;
+
+    GIVEN("A decider and frames above and below its minPowerLevel")
+    {
+        DeciderVlcUnderTest decider(&owner, &phy, 1e-7, 1e6);
+        decider.setThresholdDecoding(0.9);
+
+        std::vector<std::unique_ptr<AirFrameVlc>> frames;
+        for (double power : {1e-3, 2e-4, 5e-6, 3e-3, 1e-8}) {
+            frames.emplace_back(createFrame(power));
+        }
+
+        THEN("New frames are not processed yet")
+        {
+            for (auto& frame : frames) {
+                REQUIRE(frame->getReceptionState() == BaseDecider::NEW);
+            }
+        }
+
+        WHEN("They overlap, starting and ending in turn")
+        {
+            // index of the frame starting (>= 0) or ending (< 0, as ~index)
+            std::vector<int> events = {0, 1, 2, ~1, 3, 4, ~0, ~2, ~3, ~4};
+
+            THEN("After every change, the running sums match a recomputation over the frames on air")
+            {
+                std::set<AirFrameVlc*> onAir;
+                for (int event : events) {
+                    AirFrameVlc* frame = frames[event >= 0 ? event : ~event].get();
+                    if (event >= 0) {
+                        decider.processNewSignal(frame);
+                        onAir.insert(frame);
+                    }
+                    else {
+                        decider.processSignalEnd(frame);
+                        onAir.erase(frame);
+                        REQUIRE(frame->getReceptionState() == BaseDecider::NEW);
+                    }
+
+                    double channelPower = 0;
+                    for (auto other : onAir) channelPower += other->getReceivedPower();
+                    REQUIRE(decider.getChannelPower() == Approx(channelPower));
+
+                    auto synced = check_and_cast_nullable<AirFrameVlc*>(decider.getSyncedFrame());
+                    if (synced) {
+                        REQUIRE(decider.getSyncedInterference() == Approx(channelPower - synced->getReceivedPower()).margin(1e-12));
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("DeciderVlc records why frames were not received", "[deciderVlc]")
+{
+    DummySimulation ds(new omnetpp::cNullEnvir(0, nullptr, nullptr));
+    DummyComponent owner(&ds);
+
+    for (bool collectCollisionStatistics : {false, true}) {
+        GIVEN((collectCollisionStatistics ? "A decider which collects collision statistics" : "A decider which does not collect collision statistics"))
+        {
+            PhyStub phy;
+            DeciderVlcUnderTest decider(&owner, &phy, 1e-7, 1e6, -1, collectCollisionStatistics);
+            decider.setThresholdDecoding(0.9);
+
+            WHEN("It receives a frame alone, one overwhelmed by interference, and one below minPowerLevel")
+            {
+                std::unique_ptr<AirFrameVlc> alone(createFrame(1e-6));
+                std::unique_ptr<AirFrameVlc> synced(createFrame(1e-6));
+                std::unique_ptr<AirFrameVlc> interferer(createFrame(1e-5));
+                std::unique_ptr<AirFrameVlc> weak(createFrame(1e-8));
+
+                decider.processNewSignal(alone.get());
+                decider.processSignalEnd(alone.get());
+                decider.processNewSignal(synced.get());
+                decider.processNewSignal(interferer.get());
+                decider.processSignalEnd(synced.get());
+                decider.processSignalEnd(interferer.get());
+                decider.processNewSignal(weak.get());
+                decider.processSignalEnd(weak.get());
+                decider.finish();
+
+                THEN("Each of them is counted under its own scalar")
+                {
+                    REQUIRE(phy.framesSentUp == 1);
+                    REQUIRE(phy.scalars.at("framesDecoded") == 1);
+                    REQUIRE(phy.scalars.at("syncsLostToInterference") == 1);
+                    REQUIRE(phy.scalars.at("framesMissedWhileSynced") == 1);
+                    REQUIRE(phy.scalars.at("framesUnderMinPowerLevel") == 1);
+                    REQUIRE(phy.scalars.count("framesMissedWhileTransmitting") == 0);
+                }
+
+                THEN("The lost frame is only a collision if collision statistics are collected")
+                {
+                    if (collectCollisionStatistics) {
+                        REQUIRE(phy.scalars.at("framesNotDecoded") == 0);
+                        REQUIRE(phy.scalars.at("ncollisions") == 1);
+                    }
+                    else {
+                        REQUIRE(phy.scalars.at("framesNotDecoded") == 1);
+                        REQUIRE(phy.scalars.count("ncollisions") == 0);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/LaneIndex.h"
+
+using namespace veins;
+
+SCENARIO("LaneIndex counts the vehicles in between two vehicles of a lane", "[laneIndex]")
+{
+    GIVEN("A platoon of four vehicles added out of order and one vehicle on another lane")
+    {
+        LaneIndex index;
+        index.add(3, "edge_0", 30);
+        index.add(1, "edge_0", 10);
+        index.add(4, "edge_0", 40);
+        index.add(2, "edge_0", 20);
+        index.add(5, "edge_1", 25);
+        index.build();
+
+        THEN("Neighbors have nobody in between")
+        {
+            REQUIRE(index.isSameLane(1, 2));
+            REQUIRE(index.countInBetween(1, 2) == 0);
+            REQUIRE(index.countInBetween(4, 3) == 0);
+        }
+        THEN("The vehicles in between are counted in both directions")
+        {
+            REQUIRE(index.countInBetween(1, 4) == 2);
+            REQUIRE(index.countInBetween(3, 1) == 1);
+        }
+        THEN("Vehicles on other lanes or unknown vehicles are not on the same lane")
+        {
+            REQUIRE_FALSE(index.isSameLane(2, 5));
+            REQUIRE_FALSE(index.isSameLane(2, 6));
+        }
+        WHEN("The index is rebuilt after the vehicles moved")
+        {
+            index.clear();
+            index.add(1, "edge_0", 50);
+            index.add(2, "edge_0", 20);
+            index.add(4, "edge_0", 40);
+            index.build();
+            THEN("The new order is used")
+            {
+                REQUIRE(index.size() == 3);
+                REQUIRE_FALSE(index.contains(3));
+                REQUIRE(index.countInBetween(1, 4) == 0);
+                REQUIRE(index.countInBetween(1, 2) == 1);
+            }
+        }
+    }
+}
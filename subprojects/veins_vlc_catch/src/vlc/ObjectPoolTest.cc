@@ -0,0 +1,79 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/ObjectPool.h"
+
+using namespace veins;
+
+namespace {
+
+struct PooledObject : public Pooled<PooledObject> {
+    virtual ~PooledObject() = default;
+    double value = 0;
+};
+
+struct DerivedObject : public PooledObject {
+    double moreValues[4] = {};
+};
+
+} // namespace
+
+SCENARIO("ObjectPool reuses the memory of deleted objects", "[objectPool]")
+{
+    GIVEN("Two objects allocated from a pool without free blocks")
+    {
+        PooledObject* a = new PooledObject();
+        PooledObject* b = new PooledObject();
+        ObjectPool<PooledObject>::resetStatistics();
+        const ObjectPoolStatistics& statistics = ObjectPool<PooledObject>::getStatistics();
+
+        WHEN("One of them is deleted and a new one is allocated")
+        {
+            PooledObject* deleted = a;
+            delete a;
+            a = new PooledObject();
+
+            THEN("The memory of the deleted object is reused")
+            {
+                REQUIRE(a == deleted);
+                REQUIRE(statistics.allocations == 1);
+                REQUIRE(statistics.reuses == 1);
+                REQUIRE(statistics.inUse == 2);
+                REQUIRE(statistics.highWater == 2);
+                REQUIRE(statistics.getReuseRatio() == Approx(1.0));
+            }
+        }
+        WHEN("An object of a derived type is allocated and deleted")
+        {
+            PooledObject* derived = new DerivedObject();
+            delete derived;
+
+            THEN("It bypasses the pool")
+            {
+                REQUIRE(statistics.allocations == 0);
+                REQUIRE(statistics.inUse == 2);
+            }
+        }
+
+        delete a;
+        delete b;
+    }
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/OokPdrTable.h"
+#include "veins-vlc/utility/Utils.h"
+
+#include <cmath>
+
+using namespace veins;
+
+SCENARIO("OokPdrTable approximates getOokPdr", "[ookPdrTable]")
+{
+    GIVEN("A table with the default grid")
+    {
+        OokPdrTable table;
+
+        WHEN("Looking up the PDR of short and long packets across the grid")
+        {
+            double maxError = 0;
+            for (int length : {124, 1024, 65536}) {
+                for (double snr_dB = -9.997; snr_dB < 25; snr_dB += 0.0137) {
+                    double snr = std::pow(10, snr_dB / 10);
+                    maxError = std::max(maxError, std::fabs(table.getPdr(snr, length) - getOokPdr(snr, length)));
+                }
+            }
+
+            THEN("The error stays within the documented bound")
+            {
+                REQUIRE(table.getNumLengths() == 3);
+                REQUIRE(table.getErrorBound() < 1e-4);
+                REQUIRE(maxError <= table.getErrorBound() * 1.01);
+            }
+        }
+        WHEN("Looking up an SNR outside of the grid")
+        {
+            THEN("The exact PDR is returned")
+            {
+                REQUIRE(table.getPdr(0.01, 1000) == getOokPdr(0.01, 1000));
+                REQUIRE(table.getPdr(1000, 1000) == getOokPdr(1000, 1000));
+                REQUIRE(table.getPdr(0, 1000) == getOokPdr(0, 1000));
+            }
+        }
+    }
+    GIVEN("A table with space for a single packet length")
+    {
+        OokPdrTable table(-10, 25, 0.01, 1);
+        table.getPdr(10, 124);
+
+        THEN("Other lengths are computed exactly")
+        {
+            REQUIRE(table.getPdr(10, 1000) == getOokPdr(10, 1000));
+            REQUIRE(table.getNumLengths() == 1);
+        }
+    }
+}
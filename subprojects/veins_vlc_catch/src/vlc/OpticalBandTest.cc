@@ -0,0 +1,69 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/ConstsVlc.h"
+#include "veins-vlc/utility/OpticalBand.h"
+
+using namespace veins;
+
+SCENARIO("Optical bands are parsed and weight the responsivity of photodiodes", "[opticalBand]")
+{
+    GIVEN("Two color bands")
+    {
+        auto bands = parseOpticalBands("380-540  540-760");
+
+        THEN("Both are parsed in order")
+        {
+            REQUIRE(bands.size() == 2);
+            REQUIRE(bands[0].minWavelength_nm == 380);
+            REQUIRE(bands[1].maxWavelength_nm == 760);
+            REQUIRE(bands[0].getCenterFrequency() > bands[1].getCenterFrequency());
+            REQUIRE(bands[1].getCenterFrequency() == Approx(299792458 / 650e-9));
+        }
+
+        THEN("Overlapping bands are rejected")
+        {
+            REQUIRE_THROWS(parseOpticalBands("380-540 500-740"));
+        }
+
+        THEN("Wavelengths which are not numbers are rejected")
+        {
+            REQUIRE_THROWS_AS(parseOpticalBands("380-green"), cRuntimeError);
+            REQUIRE_THROWS_AS(parseOpticalBands("380-540nm"), cRuntimeError);
+        }
+
+        WHEN("A photodiode is twice as responsive to the upper band")
+        {
+            // flat emission, samples from 380 nm to 750 nm
+            std::vector<double> emission(SPECTRAL_SAMPLES, 1);
+            std::vector<double> response(SPECTRAL_SAMPLES, 0.2);
+            for (size_t i = 16; i < response.size(); ++i) response[i] = 0.4;
+
+            THEN("The responsivity within each band is relative to the one of the whole spectrum")
+            {
+                double lower = getBandResponsivityRatio(emission, response, bands[0]);
+                double upper = getBandResponsivityRatio(emission, response, bands[1]);
+                REQUIRE(upper == Approx(2 * lower));
+                REQUIRE(lower * 16 / 38 + upper * 22 / 38 == Approx(1));
+            }
+        }
+    }
+}
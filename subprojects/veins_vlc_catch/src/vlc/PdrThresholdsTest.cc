@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/PdrThresholds.h"
+#include "veins-vlc/utility/Utils.h"
+
+#include <cmath>
+
+using namespace veins;
+
+SCENARIO("PdrThresholds finds the SNR at which a target PDR is reached", "[pdrThresholds]")
+{
+    GIVEN("Thresholds of OOK for a target PDR of 0.9")
+    {
+        PdrThresholds thresholds(getOokPdr, 0.9);
+
+        WHEN("Looking up the threshold of short and long packets")
+        {
+            double shortThreshold = thresholds.getThreshold(124);
+            double longThreshold = thresholds.getThreshold(8000);
+
+            THEN("The PDR reaches the target just at the threshold")
+            {
+                REQUIRE(getOokPdr(shortThreshold, 124) >= 0.9);
+                REQUIRE(getOokPdr(shortThreshold * 0.999, 124) < 0.9);
+                REQUIRE(getOokPdr(longThreshold, 8000) >= 0.9);
+                REQUIRE(getOokPdr(longThreshold * 0.999, 8000) < 0.9);
+                REQUIRE(longThreshold > shortThreshold);
+            }
+        }
+    }
+    GIVEN("A PDR function which never reaches the target")
+    {
+        PdrThresholds thresholds([](double, int) { return 0.5; }, 0.9);
+
+        THEN("The threshold is infinite")
+        {
+            REQUIRE(std::isinf(thresholds.getThreshold(100)));
+        }
+    }
+}
@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/PhyModesVlc.h"
+#include "veins-vlc/utility/Utils.h"
+
+using namespace veins;
+
+SCENARIO("IEEE 802.15.7 operating modes", "[phyModes]")
+{
+    GIVEN("The PHY I modes")
+    {
+        std::vector<double> dataRates;
+        for (auto& mode : getVlcPhyModes()) {
+            if (mode.phyType == 1) dataRates.push_back(mode.getDataRate());
+        }
+
+        THEN("Their data rates are the ones of the standard")
+        {
+            std::vector<double> expected = {11.67e3, 24.44e3, 48.89e3, 73.3e3, 100e3, 35.56e3, 71.11e3, 124.4e3, 266.6e3};
+            REQUIRE(dataRates.size() == expected.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                REQUIRE(dataRates[i] == Approx(expected[i]).epsilon(0.001));
+            }
+        }
+    }
+
+    GIVEN("A chip SNR of 6 dB")
+    {
+        double snr = std::pow(10, 0.6);
+        const VlcPhyMode& uncoded = getVlcPhyMode(8);
+        const VlcPhyMode& coded = getVlcPhyMode(7);
+
+        THEN("Uncoded VPPM is 3 dB ahead of OOK")
+        {
+            REQUIRE(getVppmBer(snr) == Approx(getOokBer(2 * snr)));
+            REQUIRE(getVlcPhyModeBer(uncoded, snr) == Approx(getVppmBer(snr)));
+        }
+
+        THEN("The Reed-Solomon code reduces the BER")
+        {
+            REQUIRE(getVlcPhyModeBer(coded, snr) < getVlcPhyModeBer(uncoded, snr));
+            REQUIRE(getVlcPhyModePdr(coded, snr, 1000) > getVlcPhyModePdr(uncoded, snr, 1000));
+        }
+    }
+
+    GIVEN("The SINR at a reference bitrate of 1 Mbps")
+    {
+        THEN("A mode with a slower optical clock has a higher chip SNR")
+        {
+            REQUIRE(getVlcPhyModeSnr(getVlcPhyMode(0), 1, 1e6) == Approx(5));
+        }
+    }
+}
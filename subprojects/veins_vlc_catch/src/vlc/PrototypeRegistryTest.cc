@@ -0,0 +1,63 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/utility/PrototypeRegistry.h"
+
+using namespace veins;
+
+SCENARIO("PrototypeRegistry creates each prototype once", "[prototypeRegistry]")
+{
+    GIVEN("An empty registry")
+    {
+        PrototypeRegistry<double> registry;
+        int created = 0;
+        auto create = [&created]() {
+            ++created;
+            return std::make_shared<double>(created);
+        };
+
+        WHEN("The same key is requested twice")
+        {
+            auto first = registry.get("a", create);
+            auto second = registry.get("a", create);
+
+            THEN("Both get the same prototype")
+            {
+                REQUIRE(first == second);
+                REQUIRE(created == 1);
+                REQUIRE(registry.getHits() == 1);
+                REQUIRE(registry.getMisses() == 1);
+            }
+        }
+        WHEN("Two keys are requested")
+        {
+            auto first = registry.get("a", create);
+            auto second = registry.get("b", create);
+
+            THEN("Each gets its own prototype")
+            {
+                REQUIRE(*first == 1);
+                REQUIRE(*second == 2);
+                REQUIRE(registry.size() == 2);
+            }
+        }
+    }
+}
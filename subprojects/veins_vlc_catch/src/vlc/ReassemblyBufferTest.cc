@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "catch2/catch.hpp"
+#include "veins-vlc/mac/ReassemblyBuffer.h"
+
+using namespace veins;
+
+SCENARIO("ReassemblyBuffer completes messages once all fragments arrived", "[reassemblyBuffer]")
+{
+    GIVEN("A buffer with two slots and a timeout of 1 s")
+    {
+        ReassemblyBuffer buffer(2, 1);
+
+        WHEN("All three fragments of a message arrive, one of them twice")
+        {
+            cPacket* first = new cPacket();
+            REQUIRE(buffer.add(1, 7, 0, 3, first, 0) == nullptr);
+            REQUIRE(buffer.add(1, 7, 2, 3, nullptr, 0.1) == nullptr);
+            REQUIRE(buffer.add(1, 7, 2, 3, nullptr, 0.1) == nullptr);
+            cPacket* complete = buffer.add(1, 7, 1, 3, nullptr, 0.2);
+
+            THEN("The first fragment is returned")
+            {
+                REQUIRE(complete == first);
+                REQUIRE(buffer.size() == 0);
+                REQUIRE(buffer.getReassembled() == 1);
+                REQUIRE(buffer.getDiscarded() == 0);
+            }
+            delete complete;
+        }
+
+        WHEN("The first fragment arrives last")
+        {
+            cPacket* first = new cPacket();
+            REQUIRE(buffer.add(1, 7, 2, 3, nullptr, 0) == nullptr);
+            REQUIRE(buffer.add(1, 7, 1, 3, nullptr, 0.1) == nullptr);
+            cPacket* complete = buffer.add(1, 7, 0, 3, first, 0.2);
+
+            THEN("The message is completed all the same")
+            {
+                REQUIRE(complete == first);
+                REQUIRE(buffer.size() == 0);
+                REQUIRE(buffer.getReassembled() == 1);
+            }
+            delete complete;
+        }
+
+        WHEN("A fragment other than the first is lost")
+        {
+            buffer.add(1, 7, 0, 3, new cPacket(), 0);
+            buffer.add(1, 7, 2, 3, nullptr, 0.1);
+
+            THEN("The message is discarded after the timeout")
+            {
+                REQUIRE(buffer.size() == 1);
+                buffer.expire(1.05);
+                REQUIRE(buffer.size() == 1);
+                buffer.expire(1.2);
+                REQUIRE(buffer.size() == 0);
+                REQUIRE(buffer.getReassembled() == 0);
+                REQUIRE(buffer.getDiscarded() == 1);
+                REQUIRE(buffer.getFragmentsMissing() == 1);
+            }
+        }
+
+        WHEN("The 8 bit sequence number of a source wraps around")
+        {
+            buffer.add(1, 255, 0, 2, new cPacket(), 0);
+            buffer.add(1, 0, 0, 2, new cPacket(), 0.1);
+            cPacket* complete = buffer.add(1, 0, 1, 2, nullptr, 0.2);
+
+            THEN("The message after the wrap is completed")
+            {
+                REQUIRE(complete != nullptr);
+                REQUIRE(buffer.getReassembled() == 1);
+                REQUIRE(buffer.getDiscarded() == 1);
+            }
+            delete complete;
+        }
+
+        WHEN("A newer message of the same source starts")
+        {
+            buffer.add(1, 7, 0, 3, new cPacket(), 0);
+            buffer.add(1, 8, 0, 2, new cPacket(), 0.1);
+
+            THEN("The older one is discarded")
+            {
+                REQUIRE(buffer.size() == 1);
+                REQUIRE(buffer.getDiscarded() == 1);
+                REQUIRE(buffer.getFragmentsMissing() == 2);
+            }
+        }
+
+        WHEN("The first fragment of a message is lost")
+        {
+            buffer.add(1, 7, 1, 3, nullptr, 0);
+            buffer.add(1, 7, 2, 3, nullptr, 0);
+
+            THEN("It is never completed and discarded after the timeout")
+            {
+                REQUIRE(buffer.size() == 1);
+                buffer.expire(1.5);
+                REQUIRE(buffer.size() == 0);
+                REQUIRE(buffer.getDiscarded() == 1);
+                REQUIRE(buffer.getFragmentsMissing() == 1);
+            }
+        }
+
+        WHEN("A third source starts a message")
+        {
+            buffer.add(1, 7, 0, 2, new cPacket(), 0);
+            buffer.add(2, 3, 0, 2, new cPacket(), 0.1);
+            buffer.add(3, 5, 0, 2, new cPacket(), 0.2);
+
+            THEN("The slot which would time out next is discarded")
+            {
+                REQUIRE(buffer.size() == 2);
+                REQUIRE(buffer.getDiscarded() == 1);
+                cPacket* complete = buffer.add(2, 3, 1, 2, nullptr, 0.3);
+                REQUIRE(complete != nullptr);
+                delete complete;
+            }
+        }
+    }
+}
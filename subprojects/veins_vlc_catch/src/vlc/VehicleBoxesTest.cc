@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2026 veins_vlc contributors
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include <random>
+
+#include "catch2/catch.hpp"
+#include "veins/base/utils/Coord.h"
+#include "veins-vlc/utility/VehicleBoxes.h"
+
+using namespace veins;
+
+namespace {
+
+VehicleBoxes makeTrafficJam(size_t numVehicles, std::mt19937& rng)
+{
+    std::uniform_real_distribution<double> position(0, 500);
+    std::uniform_real_distribution<double> angle(0, 2 * M_PI);
+    VehicleBoxes boxes;
+    for (size_t i = 0; i < numVehicles; ++i) {
+        double a = angle(rng);
+        boxes.add(i, Coord(position(rng), position(rng) / 10), Coord(cos(a), sin(a)), 5, 1.8);
+    }
+    return boxes;
+}
+
+} // namespace
+
+SCENARIO("VehicleBoxes finds the vehicles blocking a line of sight", "[vehicleBoxes]")
+{
+    GIVEN("Three cars driving east in a row and one car on the next lane")
+    {
+        VehicleBoxes boxes;
+        boxes.add(1, Coord(10, 0), Coord(1, 0), 5, 2);
+        boxes.add(2, Coord(20, 0), Coord(1, 0), 5, 2);
+        boxes.add(3, Coord(30, 0), Coord(1, 0), 5, 2);
+        boxes.add(4, Coord(20, 4), Coord(1, 0), 5, 2);
+
+        THEN("The middle car blocks the first and the last car")
+        {
+            REQUIRE(boxes.isBlocked(Coord(10, 0), Coord(25, 0), 1, 3));
+            REQUIRE(boxes.isBlockedScalar(Coord(10, 0), Coord(25, 0), 1, 3));
+        }
+        THEN("Neighbors can see each other")
+        {
+            REQUIRE_FALSE(boxes.isBlocked(Coord(10, 0), Coord(15, 0), 1, 2));
+            REQUIRE_FALSE(boxes.isBlockedScalar(Coord(10, 0), Coord(15, 0), 1, 2));
+        }
+        THEN("A diagonal line of sight is blocked by the car on the next lane")
+        {
+            REQUIRE(boxes.isBlocked(Coord(10, 0), Coord(30, 8), 1, -1));
+            REQUIRE_FALSE(boxes.isBlocked(Coord(10, 0), Coord(30, 25), 1, -1));
+        }
+    }
+    GIVEN("A traffic jam of randomly placed vehicles")
+    {
+        std::mt19937 rng(42);
+        VehicleBoxes boxes = makeTrafficJam(301, rng);
+        std::uniform_real_distribution<double> position(0, 500);
+
+        THEN("The SIMD and the scalar test agree")
+        {
+            for (int i = 0; i < 1000; ++i) {
+                Coord senderPos(position(rng), position(rng) / 10);
+                Coord receiverPos = senderPos + Coord(position(rng) / 10 - 25, position(rng) / 100 - 2.5);
+                REQUIRE(boxes.isBlocked(senderPos, receiverPos, 0, 1) == boxes.isBlockedScalar(senderPos, receiverPos, 0, 1));
+            }
+        }
+    }
+}
+